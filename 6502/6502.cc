@@ -20,7 +20,16 @@
 
 //////////
 // CPU Setup and reset
-MOS6502::MOS6502(Memory<Word, Byte>& m) : debugger(*this), _instructions(setupInstructionMap()), mem(m), _inReset(true) {}	
+MOS6502::MOS6502(Memory<Word, Byte>& m) : MOS6502(m, instructionMap().data()) {}
+
+MOS6502::MOS6502(Memory<Word, Byte>& m, const instruction* instructions) : 
+	debugger(*this), _instructions(instructions), mem(m) {
+	mem.setCodeChangedCallback([this](Word address) { codeChanged(address); });
+}
+
+MOS6502::~MOS6502() {
+	mem.setCodeChangedCallback(nullptr);
+}
 
 void MOS6502::setResetVector(const Word address) {
 	writeWord(RESET_VECTOR, address);
@@ -35,32 +44,40 @@ void MOS6502::setNMIVector(const Word address) {
 }
 
 bool MOS6502::inReset() { 
-	return _inReset; 
+	return _pendingEvents & Event::Reset; 
 }
 
 void MOS6502::raiseIRQ() { 
-	_pendingIRQ = true; 
+	_pendingEvents |= Event::IRQ; 
 }
 
 void MOS6502::raiseNMI() { 
-	_pendingNMI = true; 
+	_pendingEvents |= Event::NMI; 
 }
 
 bool MOS6502::pendingIRQ() { 
-	return _pendingIRQ; 
+	return _pendingEvents & Event::IRQ; 
 }
 
 bool MOS6502::pendingNMI() { 
-	return _pendingNMI; 
+	return _pendingEvents & Event::NMI; 
 }
 	
 void MOS6502::unsetHaltAddress() { 
 	_haltAddressSet = false; 
+	updateStopAddress(_haltAddress);
 }
 
 void MOS6502::setHaltAddress(const Word _pc) {
+	unsetHaltAddress();
 	_haltAddress = _pc;
 	_haltAddressSet = true;
+	updateStopAddress(_haltAddress);
+}
+
+// Recompute whether run() needs to stop at @address
+void MOS6502::updateStopAddress(const Word address) {
+	_stopAddresses[address] = (_haltAddressSet && address == _haltAddress) || debugger.isBreakpoint(address);
 }
 
 bool MOS6502::isPCAtHaltAddress() {
@@ -80,15 +97,18 @@ bool MOS6502::loopDetected() {
 }
 
 bool MOS6502::isInDebugMode() { 
-	return _debugMode; 
+	return _pendingEvents & Event::Debug; 
 }
 
 void MOS6502::setDebugMode(const bool m) { 
-	_debugMode = m; 
+	if (m)
+		_pendingEvents |= Event::Debug;
+	else
+		_pendingEvents &= ~Event::Debug;
 }
 
 bool MOS6502::hitException() { 
-	return _hitException; 
+	return _pendingEvents & Event::Exception; 
 }
 
 Cycles_t MOS6502::expectedCycles() {
@@ -112,12 +132,10 @@ void MOS6502::exitReset() {
 	_testReset = false;
 #endif
 
-	_debugMode = false;
 	debugger.setCPUStatusAtPrompt(false); // TODO: Need a debugger.Reset()? 
 
-	_hitException = false;
-
-	_inReset = false;
+	// Leave the debugger, clear any exception and come out of reset
+	_pendingEvents &= ~(Event::Debug | Event::Exception | Event::Reset);
 
 	_cycles += 7;		
 }	
@@ -126,7 +144,7 @@ void MOS6502::exitReset() {
 // Program Counter and Stack Pointer values, exits reset so that the next call to execute() executes code.
 #ifdef TEST_BUILD
 void MOS6502::TestReset(const Word initialPC, const Byte initialSP)  {
-	_inReset = true;
+	_pendingEvents |= Event::Reset;
 	_testReset = true;
 	_testResetPC = initialPC;
 	_testResetSP = initialSP;
@@ -136,10 +154,9 @@ void MOS6502::TestReset(const Word initialPC, const Byte initialSP)  {
 
 // 'Asserts' the Reset line if not asserted, de-asserts the Reset line if asserted. 
 void MOS6502::Reset() {
-	if (!_inReset) {		// Not in Reset, assert the Reset line
-		_inReset = true;
+	if (!inReset()) {		// Not in Reset, assert the Reset line
+		_pendingEvents |= Event::Reset;
 	} else {				// In Reset, de-assert Reset
-		_inReset = false;
 		exitReset();
 	}
 }
@@ -161,7 +178,7 @@ bool MOS6502::NMI() {
 		debugger.addBacktraceInterrupt(PC);
 		_NMICount++;
 		interrupt(NMI_VECTOR);
-		_pendingNMI = false;
+		_pendingEvents &= ~Event::NMI;
 		return true;
 	}
 
@@ -173,7 +190,7 @@ bool MOS6502::IRQ() {
 		debugger.addBacktraceInterrupt(PC);
 		_IRQCount++;
 		interrupt(INTERRUPT_VECTOR);
-		_pendingIRQ = false;
+		_pendingEvents &= ~Event::IRQ;
 		return true;
 	}
 
@@ -184,10 +201,10 @@ bool MOS6502::IRQ() {
 // CPU Exception
 void MOS6502::exception(const std::string& message) {
 	std::string msg = "CPU Exception: " + message;
-	_hitException = true;
+	_pendingEvents |= Event::Exception;
 	
-	if (debugger.debugModeOnException() || _debugMode) {
-		_debugMode = true;
+	if (debugger.debugModeOnException() || isInDebugMode()) {
+		setDebugMode(true);
 		fmt::print("\n{}\n", msg);
 	} else {
 		throw std::runtime_error(msg);
@@ -202,12 +219,17 @@ bool MOS6502::isNegative(const Byte val) {
 	return (val & NegativeBit);
 }
 
-void MOS6502::setFlagNByValue(const Byte val) {
-	Flags.N = isNegative(val);
+// PS with N and Z brought up to date
+Byte MOS6502::statusRegister() {
+	Flags.N = flagN();
+	Flags.Z = flagZ();
+	return PS;
 }
 
-void MOS6502::setFlagZByValue(const Byte val) {
-	Flags.Z = (val == 0);
+void MOS6502::setStatusRegister(const Byte ps) {
+	PS = ps;
+	setFlagNByValue(Flags.N ? 0x80 : 0);
+	setFlagZByValue(Flags.Z ? 0 : 1);
 }
 
 bool MOS6502::IRQBlocked() {
@@ -243,27 +265,34 @@ Word MOS6502::readWordAtPC() {
 }
 
 Byte MOS6502::readByteAtPC() {
-	Byte opcode = readByte(PC);
+	Byte data;
+
+	// Instructions run from the block cache carry their operands with them
+	if (_operands) {
+		data = *_operands++;
+		_cycles++;
+	} else {
+		data = mem.Fetch(PC);
+		_cycles++;
+	}
+
 	PC++;
-	return opcode;
+	return data;
 }
 
 //////////
 // Instructions
 bool MOS6502::validInstruction(const Byte opcode) {
-	return _instructions.count(opcode) != 0;
-	       
+	return _instructions[opcode].opfn != nullptr;
 }
 
 const char* MOS6502::instructionName(const Byte opcode) {
-	if (validInstruction(opcode)) 
-		return _instructions.at(opcode).name;
-	return nullptr;
+	return _instructions[opcode].name;
 }
 
 bool MOS6502::decodeInstruction(const Byte opcode, struct instruction& ins) {
 	if (validInstruction(opcode)) {
-		ins = _instructions.at(opcode);
+		ins = _instructions[opcode];
 		return true;
 	}
 
@@ -271,15 +300,15 @@ bool MOS6502::decodeInstruction(const Byte opcode, struct instruction& ins) {
 }
 
 bool MOS6502::instructionIsAddressingMode(const Byte opcode, const AddressingMode addrMode) {
-	return validInstruction(opcode) && _instructions.at(opcode).addrmode == addrMode;
+	return validInstruction(opcode) && _instructions[opcode].addrmode == addrMode;
 }
 
 bool MOS6502::instructionHasFlags(const Byte opcode, const Byte flags) {
-	return validInstruction(opcode) && ((_instructions.at(opcode).flags & flags) != 0);
+	return validInstruction(opcode) && ((_instructions[opcode].flags & flags) != 0);
 }
 
 MOS6502::AddressingMode MOS6502::getInstructionAddressingMode(const Byte opcode) {
-	return _instructions.at(opcode).addrmode;
+	return _instructions[opcode].addrmode;
 }
 
 //////////
@@ -314,132 +343,24 @@ void MOS6502::pushPS() {
 	constexpr Byte BreakBit  = 1 << 4;
 	constexpr Byte UnusedBit = 1 << 5;
 
-	push(PS | UnusedBit | BreakBit);
+	push(statusRegister() | UnusedBit | BreakBit);
 }
 
 void MOS6502::popPS() {
-	PS = pop();
+	setStatusRegister(pop());
 	Flags.B = false;
 	Flags._unused = false;
 }
 
-//////////
-// Address decoding
-Word MOS6502::getAddress(const Byte opcode) {
-	Word address;
-	SByte rel;
-
-	// Add a cycle if a page boundary is crossed
-	auto updateCycles = [&](Byte reg) {
-		if (instructionHasFlags(opcode, InstructionFlags::PageBoundary)) {
-			if (((address + reg) >> 8) != (address >> 8)) {
-				_expectedCyclesToUse++;
-				_cycles++;
-			}
-		} else 
-			_cycles++;
-	};
-
-	auto addressMode = getInstructionAddressingMode(opcode); 
-	
-	switch(addressMode) {
-
-    // ZeroPage mode
-	case AddressingMode::ZeroPage:
-		address = readByteAtPC();
-		break;
-
-	// ZeroPage,X (with zero page wrap around)
-	case AddressingMode::ZeroPageX:
-		address = static_cast<Byte>(readByteAtPC() + X);
-		_cycles++;
-		break;
-
-	// ZeroPage,Y (with zero page wrap around)
-	case AddressingMode::ZeroPageY:
-		address = static_cast<Byte>(readByteAtPC() + Y);
-		_cycles++;
-		break;
-
-	// Relative
-	case AddressingMode::Relative:
-		rel = static_cast<SByte>(readByteAtPC());
-		address = static_cast<Word>(PC + rel);
-		break;
-
-	// Absolute
-	case AddressingMode::Absolute:
-		address = readWordAtPC();
-		break;
-
-	// Absolute,X 
-	case AddressingMode::AbsoluteX:
-		address = readWordAtPC();
-		updateCycles(X);
-		address += X;
-		break;
-
-	// Absolute,Y 
-	case AddressingMode::AbsoluteY:
-		address = readWordAtPC();
-		updateCycles(Y);
-		address += Y;
-		break;
-
-    // (Indirect,X) or Indexed Indirect (with zero page wrap around)
-	case AddressingMode::IndirectX:	
-		address = static_cast<Byte>(readByteAtPC() + X);
-		address = readWord(address);
-		_cycles++;
-		break;
-
-	// (Indirect),Y or Indirect Indexed
-	case AddressingMode::IndirectY:
-		address = readByteAtPC();
-		address = readWord(address) + Y;
-		break;
-
-	case AddressingMode::Implied:
-	case AddressingMode::Accumulator:
-	case AddressingMode::Immediate:
-	case AddressingMode::Indirect:
-		exception("Can't decoded address for Accumulator, Immediate or Indirect opcode");
-		break;
-
-	default:
-		exception("Invalid addressing mode");
-		break;
-	}
-	
-	return address;
-}
-
-Byte MOS6502::getData(const Byte opcode) {
-	Byte data;
-
-	if (instructionIsAddressingMode(opcode, AddressingMode::Immediate)) {
-		data = readByteAtPC();
-	} else {
-		Word address = getAddress(opcode);
-		data = readByte(address);
-	}
-
-	return data;
-}
-
 //////////
 // Instruction execution
 void MOS6502::executeOneInstruction() {
-	Byte opcode;
-	Word startPC;
-	struct instruction ins;
-
 	if (hitException()) {
 		fmt::print("CPU has hit an exception\n");
 		return;
 	}
 	
- 	if (_inReset)
+ 	if (inReset())
 		return;
 
 	// Reset cycle count before executing each instruction.
@@ -454,12 +375,22 @@ void MOS6502::executeOneInstruction() {
 	if (NMI() || IRQ()) 
 		return;
 
+	dispatchInstruction();
+	mem.flushObservers();
+}
+
+// Fetch, decode and execute the instruction at PC
+void MOS6502::dispatchInstruction() {
+	Byte opcode;
+	Word startPC;
+
 	// Saving the PC has to happen before readByteAtPC(), which consumes clock cycles and increments the PC
 	startPC = PC;
+	_operands = nullptr;
 
 	opcode = readByteAtPC();
-	auto validOpcode = decodeInstruction(opcode, ins);
-	if (!validOpcode) {
+	const auto& ins = _instructions[opcode];
+	if (ins.opfn == nullptr) {
 		PC = startPC;
 		auto s = fmt::format("Invalid opcode {:02x} at PC {:04x}", opcode, PC);
 		exception(s);
@@ -468,8 +399,11 @@ void MOS6502::executeOneInstruction() {
 
 	_expectedCyclesToUse = ins.cycles;
 
-	ins.opfn(opcode);
+	(this->*ins.opfn)(opcode);
+	checkForLoop(startPC);
+}
 
+void MOS6502::checkForLoop(const Word startPC) {
 	if ( startPC == PC) {
 		if (_loopDetected) {
 			auto s = fmt::format("Recursive loop detected");
@@ -487,13 +421,13 @@ void MOS6502::executeOneInstruction() {
 
 void MOS6502::execute() {
 
-	if (debugger.isPCBreakpoint() && !_debugMode) {
+	if (debugger.isPCBreakpoint() && !isInDebugMode()) {
 		// Set debug mode and return so the caller can setup the terminal if needed.
-		_debugMode = true;
+		setDebugMode(true);
 		return;
 	}
 
-	if (_debugMode) {
+	if (isInDebugMode()) {
 		debugger.executeDebug();
 		return;
 	}
@@ -501,6 +435,75 @@ void MOS6502::execute() {
 	executeOneInstruction();
 }
 
+//////////
+// Batched execution
+
+uint64_t MOS6502::run(const uint64_t cycles) {
+	return runUntil(cycles, UINT64_MAX);
+}
+
+uint64_t MOS6502::runInstructions(const uint64_t instructions) {
+	return runUntil(UINT64_MAX, instructions);
+}
+
+// Ask a run() in progress to return before the next instruction.  Intended for devices and other
+// callers that need the CPU to hand control back to the main loop.
+void MOS6502::stop() {
+	_pendingEvents |= Event::Stop;
+}
+
+// Check for anything that ends a run.  Only called when an event is pending or PC is a stop address.
+bool MOS6502::stopRun() {
+	if (_pendingEvents & (Event::Reset | Event::Exception | Event::Debug))
+		return true;
+
+	if (_pendingEvents & Event::Stop) {
+		_pendingEvents &= ~Event::Stop;
+		return true;
+	}
+
+	if (_stopAddresses[PC]) {
+		// Like execute(), enter debug mode at a breakpoint and let the caller setup the terminal
+		if (debugger.isPCBreakpoint())
+			setDebugMode(true);
+		return true;
+	}
+
+	return false;
+}
+
+uint64_t MOS6502::runUntil(const uint64_t cycleBudget, const uint64_t instructionBudget) {
+	uint64_t cyclesUsed = 0;
+	uint64_t instructions = 0;
+
+	while (cyclesUsed < cycleBudget && instructions < instructionBudget) {
+		_cycles = 0;
+
+		if (actionableEvents() || _stopAddresses[PC]) [[unlikely]] {
+			if (stopRun())
+				break;
+
+			// A pending interrupt is taken in place of the next instruction
+			if (NMI() || IRQ()) {
+				cyclesUsed += _cycles;
+				continue;
+			}
+		}
+
+		if (_blockCacheEnabled) {
+			executeBlock(cyclesUsed, instructions, cycleBudget, instructionBudget);
+			continue;
+		}
+
+		dispatchInstruction();
+		cyclesUsed += _cycles;
+		instructions++;
+	}
+
+	mem.flushObservers();
+	return cyclesUsed;
+}
+
 //////////
 // CPU information 
 
@@ -512,13 +515,14 @@ void MOS6502::printCPUState() {
 		return b ? std::toupper(c) : std::tolower(c);
 	};
 
+	statusRegister();
 	fmt::print("  | PC: {:04x} SP: {:02x}\n", PC, SP );
 	// fmt::print() doesn't like to print out union/bit-field members?
 	fmt::print("  | Flags: {}{}{}{}{}{}{} (PS: {:#x})\n",
 		fl('C', Flags.C), fl('Z', Flags.Z), fl('I', Flags.I), fl('D', Flags.D), fl('B', Flags.B), fl('V', Flags.V), 
 		fl('N', Flags.N), PS);
 	fmt::print("  | A: {:02x} X: {:02x} Y: {:02x}\n", A, X, Y );
-	fmt::print("  | Pending: IRQ - {}, NMI - {}, inReset? - {}\n", yesno(pendingIRQ()), yesno(pendingNMI()), yesno(_inReset));
+	fmt::print("  | Pending: IRQ - {}, NMI - {}, inReset? - {}\n", yesno(pendingIRQ()), yesno(pendingNMI()), yesno(inReset()));
 	fmt::print("  | IRQs: {}, NMIs: {}, BRKs: {}\n", _IRQCount, _NMICount, _BRKCount);
 	fmt::print("\n");
 }
@@ -531,9 +535,10 @@ void MOS6502::Stack() {
 	if (p == SP)
 		fmt::print("Empty stack\n");
 
+	const auto stack = mem.readBlock(STACK_FRAME, STACK_FRAME | 0xff);
 	while (p != SP) {
 		a = STACK_FRAME | p;
-		fmt::print("[{:04x}] {:02x}\n", a, mem.Read(a));
+		fmt::print("[{:04x}] {:02x}\n", a, stack[p]);
 		p--;
 	}
 }
@@ -22,15 +22,19 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <iostream>
+#include <span>
 #include <vector>
 #include <chrono>
 #include <thread>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 
 // Types used by 6502
 using Byte      = uint8_t;
@@ -54,6 +58,7 @@ public:
 
 	// CPU Setup & reset
 	MOS6502(Memory<Word, Byte>&);
+	virtual ~MOS6502();
 
 	void Reset();
 
@@ -71,6 +76,7 @@ public:
 	void unsetHaltAddress();
 	void setHaltAddress(Word);
 	bool isPCAtHaltAddress();
+	Word getPC() { return PC; }
 	void enableLoopDetection(bool);
 	bool isLoopDetectionEnabled();
 	bool loopDetected();
@@ -84,39 +90,56 @@ public:
 	// Execution
 	void execute();
 
+	// Batched execution
+	//   Run until a cycle or instruction budget is used up, or until something needs the caller's
+	//   attention: a breakpoint, the halt address, an exception, reset, the debugger or a call to
+	//   stop().  Interrupts are taken without leaving the loop.  Both return the cycles used.
+	uint64_t run(uint64_t cycles);
+	uint64_t runInstructions(uint64_t instructions);
+	void stop();
+
+	// Block cache used by run(); on by default
+	void enableBlockCache(bool);
+	bool isBlockCacheEnabled();
+
+	// Machine snapshots: CPU state, memory contents and map, and the state of mapped devices
+	std::vector<uint8_t> saveSnapshot();
+	void restoreSnapshot(std::span<const uint8_t>);
+	void saveSnapshot(const std::string&);
+	void restoreSnapshot(const std::string&);
+
 #ifdef TEST_BUILD
 	void TestReset(Word initialPC = RESET_VECTOR, Byte initialSP = INITIAL_SP);
 	void traceOneInstruction();
 
-	Word getPC() { return PC; }
 	Byte getSP() { return SP; } 
 	Byte getA()  { return A;  }
 	Byte getX()  { return X;  }
 	Byte getY()  { return Y;  }
-	Byte getPS() { return PS; }
+	Byte getPS() { return statusRegister(); }
 
 	bool getFlagC() { return Flags.C; }
-	bool getFlagZ() { return Flags.Z; }
+	bool getFlagZ() { return flagZ(); }
 	bool getFlagI() { return Flags.I; }
 	bool getFlagD() { return Flags.D; }
 	bool getFlagB() { return Flags.B; }
 	bool getFlagV() { return Flags.V; }
-	bool getFlagN() { return Flags.N; }
+	bool getFlagN() { return flagN(); }
 
 	void setPC(Word _PC) { PC = _PC; }
 	void setSP(Byte _SP) { SP = _SP; }
 	void setA(Byte _A)   { A = _A; }
 	void setX(Byte _X)   { X = _X; }
 	void setY(Byte _Y)   { Y = _Y; }
-	void setPS(Byte _PS) { PS = _PS; }
+	void setPS(Byte _PS) { setStatusRegister(_PS); }
 	
 	void setFlagC(bool _v) { Flags.C = _v ? 1 : 0; }
-	void setFlagZ(bool _v) { Flags.Z = _v ? 1 : 0; }
+	void setFlagZ(bool _v) { setFlagZByValue(_v ? 0 : 1); }
 	void setFlagI(bool _v) { Flags.I = _v ? 1 : 0; }
 	void setFlagD(bool _v) { Flags.D = _v ? 1 : 0; }
 	void setFlagB(bool _v) { Flags.B = _v ? 1 : 0; }
 	void setFlagV(bool _v) { Flags.V = _v ? 1 : 0; }
-	void setFlagN(bool _v) { Flags.N = _v ? 1 : 0; }
+	void setFlagN(bool _v) { setFlagNByValue(_v ? 0x80 : 0); }
 #endif
 
 	// 6502 Opcode definitions
@@ -287,7 +310,8 @@ protected:
 	// Disassembler
 	Word disassemble(Word, uint64_t);
 	Word disassembleAt(Word, std::string&);
-	virtual void decodeArgs(Word&, const bool, const Byte, std::string &, std::string&, std::string&, std::string&);
+	void decodeArgs(Word&, const bool, const Byte, std::string &, std::string&, std::string&, std::string&);
+	void decodeRockwellArgs(Word&, std::string&, std::string&, std::string&);
 
 	Cycles_t _cycles = 0;              // Cycle counter
 	Cycles_t _expectedCyclesToUse = 0; 
@@ -327,7 +351,10 @@ protected:
 		IndirectX,
 		IndirectY,
 		Implied,
-		Accumulator
+		Accumulator,
+		// 65C02 modes
+		ZeroPageIndirect,
+		AbsoluteIndexedIndirect
 	};
 	
     // Some instructions add to the cycle count if they branch or when instructions fetch data across page 
@@ -337,10 +364,13 @@ protected:
 		static constexpr uint8_t None           = 0;
 		static constexpr uint8_t Branch         = 1;
 		static constexpr uint8_t PageBoundary   = 2;
+		static constexpr uint8_t EndsBlock      = 0x80;	// Doesn't fall through; variants add flags below this
 	};
 	
 	// Instruction map
-	using opfn_t = std::function<void(Byte)>;
+	//   A dense table of 256 entries indexed by opcode.  Entries for invalid opcodes have a null
+	//   name and opfn.  Tables are built once per CPU type and shared, read-only, by every instance.
+	using opfn_t = void (MOS6502::*)(Byte);
 	struct instruction {
 		const char *name;
 	    AddressingMode addrmode;
@@ -349,17 +379,23 @@ protected:
 		uint8_t flags;
 		opfn_t opfn;
 	};
-	using _instructionMap_t = std::map<Byte, instruction>;
-	_instructionMap_t _instructions;
+	using _instructionMap_t  = std::array<instruction, 256>;
+	using _instructionList_t = std::initializer_list<std::pair<Byte, instruction>>;
+	const instruction* _instructions;
+
+	// For variants, which pass in their own instruction table
+	MOS6502(Memory<Word, Byte>&, const instruction*);
 
-	const _instructionMap_t setupInstructionMap();
+	static const _instructionMap_t& instructionMap();
+	static _instructionMap_t setupInstructionMap();
+	static void addInstructions(_instructionMap_t&, _instructionList_t);
 
 	// Instructions
 	bool validInstruction(const Byte);
 	const char* instructionName(const Byte);
 	bool decodeInstruction(const Byte, struct instruction&);
 	MOS6502::AddressingMode getInstructionAddressingMode(const Byte);
-	virtual bool instructionIsAddressingMode(const Byte, const AddressingMode);
+	bool instructionIsAddressingMode(const Byte, const AddressingMode);
 	bool instructionHasFlags(const Byte, const Byte);
 
 	// CPU functions
@@ -370,8 +406,18 @@ protected:
 	void Stack();
 	
 	// Flags
-	void setFlagZByValue(Byte);
-	void setFlagNByValue(Byte);
+	//   N and Z are evaluated lazily.  Instructions record the value each flag comes from and the
+	//   flag is only worked out when it's read.  Flags.N and Flags.Z are stale until
+	//   statusRegister() brings PS up to date; setStatusRegister() loads them back.
+	Byte _nValue = 0;	// N is bit 7 of this value
+	Byte _zValue = 1;	// Z is set when this value is zero
+
+	void setFlagZByValue(const Byte v) { _zValue = v; }
+	void setFlagNByValue(const Byte v) { _nValue = v; }
+	bool flagZ() { return _zValue == 0; }
+	bool flagN() { return _nValue & 0x80; }
+	Byte statusRegister();
+	void setStatusRegister(Byte);
 	bool isNegative(Byte);
 	bool IRQBlocked();
 
@@ -392,17 +438,20 @@ protected:
 	Word readWord(Word);
 
 	// Address decoding
-	virtual Word getAddress(Byte);
-	virtual Byte getData(Byte);
+	//   Resolved at compile time for each addressing mode; see instructions.h
+	//   flags is the InstructionFlags of the opcode being run, so the page boundary penalty is
+	//   fixed when the instruction table is built.
+	template<AddressingMode, uint8_t flags = InstructionFlags::None> Word getAddress(Byte);
+	template<AddressingMode, uint8_t flags = InstructionFlags::None> Byte getData(Byte);
 
 	// Instruction implementations
-	void ins_adc(Byte);
-	void ins_and(Byte);
-	void ins_asl(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_adc(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_and(Byte);
+	template<AddressingMode> void ins_asl(Byte);
 	void ins_bcc(Byte);
 	void ins_bcs(Byte);
 	void ins_beq(Byte);
-	void ins_bit(Byte);
+	template<AddressingMode> void ins_bit(Byte);
 	void ins_bmi(Byte);
 	void ins_bne(Byte);
 	void ins_bpl(Byte);
@@ -413,39 +462,39 @@ protected:
 	void ins_cld(Byte);
 	void ins_cli(Byte);
 	void ins_clv(Byte);
-	void ins_cmp(Byte);
-	void ins_cpx(Byte);
-	void ins_cpy(Byte);
-	void ins_dec(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_cmp(Byte);
+	template<AddressingMode> void ins_cpx(Byte);
+	template<AddressingMode> void ins_cpy(Byte);
+	template<AddressingMode> void ins_dec(Byte);
 	void ins_dex(Byte);
 	void ins_dey(Byte);
-	void ins_eor(Byte);
-	void ins_inc(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_eor(Byte);
+	template<AddressingMode> void ins_inc(Byte);
 	void ins_inx(Byte);
 	void ins_iny(Byte);
-	void ins_jmp(Byte);
+	template<AddressingMode> void ins_jmp(Byte);
 	void ins_jsr(Byte);
-	void ins_lda(Byte);
-	void ins_ldx(Byte);
-	void ins_ldy(Byte);
-	void ins_lsr(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_lda(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_ldx(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_ldy(Byte);
+	template<AddressingMode> void ins_lsr(Byte);
 	void ins_nop(Byte);
-	void ins_ora(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_ora(Byte);
 	void ins_pha(Byte);
 	void ins_pla(Byte);
 	void ins_php(Byte);
 	void ins_plp(Byte);
-	void ins_rol(Byte);
-	void ins_ror(Byte);
+	template<AddressingMode> void ins_rol(Byte);
+	template<AddressingMode> void ins_ror(Byte);
 	void ins_rti(Byte);
 	void ins_rts(Byte);
-	void ins_sbc(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_sbc(Byte);
 	void ins_sec(Byte);
 	void ins_sed(Byte);
 	void ins_sei(Byte);
-	void ins_sta(Byte);
-	void ins_stx(Byte);
-	void ins_sty(Byte);
+	template<AddressingMode> void ins_sta(Byte);
+	template<AddressingMode> void ins_stx(Byte);
+	template<AddressingMode> void ins_sty(Byte);
 	void ins_tax(Byte);
 	void ins_tay(Byte);
 	void ins_tsx(Byte);
@@ -456,7 +505,6 @@ protected:
 private:
 
 	Memory<Word, Byte>& mem;
-	bool _debugMode = false;
 
 	//////////
 	// Special addresses/vectors
@@ -473,10 +521,30 @@ private:
 	uint64_t _NMICount = 0;
 	uint64_t _BRKCount = 0;
 
-	bool _inReset      = false;      // CPU is held in reset
-	bool _pendingIRQ   = false;
-	bool _pendingNMI   = false;
-	bool _hitException = false;
+	// Pending events
+	//   Everything that has to be looked at between instructions sets a bit here, so the run loop
+	//   only has to test one word (plus the stop address bitmap) before each instruction.
+	class Event {
+	public:
+		static constexpr uint32_t None      = 0;
+		static constexpr uint32_t Reset     = 1 << 0;	// CPU is held in reset
+		static constexpr uint32_t NMI       = 1 << 1;
+		static constexpr uint32_t IRQ       = 1 << 2;
+		static constexpr uint32_t Exception = 1 << 3;
+		static constexpr uint32_t Debug     = 1 << 4;	// Debugger is active
+		static constexpr uint32_t Stop      = 1 << 5;	// stop() was called
+	};
+	uint32_t _pendingEvents = Event::Reset;
+
+	// Pending events that can act now.  An IRQ raised while interrupts are disabled waits, without
+	// stopping the run, until they're enabled.
+	uint32_t actionableEvents() const {
+		return Flags.I ? _pendingEvents & ~Event::IRQ : _pendingEvents;
+	}
+
+	// Addresses that stop run(): the halt address and any breakpoints
+	std::bitset<LAST_ADDRESS + 1> _stopAddresses;
+	void updateStopAddress(Word);
 
 	Word _haltAddress = 0;
 	bool _haltAddressSet = false;
@@ -485,15 +553,61 @@ private:
 	bool _loopDetected = false;
 
 	void executeOneInstruction();
+	void dispatchInstruction();
+	void checkForLoop(Word);
+	bool stopRun();
+	uint64_t runUntil(uint64_t, uint64_t);
 	void exitReset();
+
+	// Block cache
+	//   run() executes straight-line code from blocks of pre-decoded instructions, built the
+	//   first time their start address is reached.  Each decoded instruction carries its handler,
+	//   expected cycles and operand bytes, so executing it skips the opcode table and the operand
+	//   reads from memory.  Memory reports writes to pages we've decoded from; a write to a byte
+	//   holding decoded code bumps that page's generation, which retires every block built from it.
+	struct decodedInstruction {
+		opfn_t opfn;
+		Word address;
+		Byte opcode;
+		Byte cycles;
+		Byte operands[2];
+	};
+	struct block {
+		std::vector<decodedInstruction> instructions;
+		std::array<Byte, 2> pages;
+		std::array<uint32_t, 2> generations;
+	};
+	// State of run() while it's inside a block
+	struct blockRun {
+		uint64_t cyclesUsed;
+		uint64_t instructions;
+		const uint64_t cycleBudget;
+		const uint64_t instructionBudget;
+		const uint32_t generation;
+		const decodedInstruction* end;
+	};
+	constexpr static size_t MAX_BLOCK_INSTRUCTIONS = 32;
+	bool _blockCacheEnabled = true;
+	std::vector<std::unique_ptr<block>> _blockCache;
+	std::array<uint32_t, 256> _pageGenerations{};
+	std::bitset<LAST_ADDRESS + 1> _codeBytes;
+	uint32_t _codeGeneration = 0;	// Bumped on every invalidation
+	const Byte* _operands = nullptr;	// Operands of the instruction executing from a block
+
+	const block& getBlock(Word);
+	void buildBlock(Word, block&);
+	bool blockIsCurrent(const block&);
+	void executeBlock(uint64_t&, uint64_t&, uint64_t, uint64_t);
+	bool executeDecoded(const decodedInstruction*, blockRun&);
+	void codeChanged(Word);
 	
 	// Helper functions for instruction implementations
 	void doBranch(bool, Byte);
 	void doADC(Byte);
 	void bcdADC(Byte);
 	void bcdSBC(Byte);
-	void getAorData(Byte&, Byte, Word&);
-	void putAorData(Byte, Byte, Word);
+	template<AddressingMode> void getAorData(Byte&, Byte, Word&);
+	template<AddressingMode> void putAorData(Byte, Word);
 
 #ifdef TEST_BUILD	
 	Word _testResetPC = 0;
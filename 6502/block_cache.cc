@@ -0,0 +1,162 @@
+//
+// Pre-decoded instruction blocks used by run()
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <6502.h>
+
+void MOS6502::enableBlockCache(const bool enable) {
+	_blockCacheEnabled = enable;
+}
+
+bool MOS6502::isBlockCacheEnabled() {
+	return _blockCacheEnabled;
+}
+
+const MOS6502::block& MOS6502::getBlock(const Word address) {
+	if (_blockCache.empty())
+		_blockCache.resize(LAST_ADDRESS + 1);
+
+	auto& b = _blockCache[address];
+	if (!b) {
+		b = std::make_unique<block>();
+		buildBlock(address, *b);
+	} else if (!blockIsCurrent(*b))
+		buildBlock(address, *b);
+
+	return *b;
+}
+
+bool MOS6502::blockIsCurrent(const block& b) {
+	return b.generations[0] == _pageGenerations[b.pages[0]] &&
+		b.generations[1] == _pageGenerations[b.pages[1]];
+}
+
+// Decode from start until an instruction that ends the block, an invalid opcode, a device or an
+// address observed for fetches.  These are left to the interpreter so reads of them still happen,
+// and get reported, as the program makes them.  Code is decoded with Peek(), so observers only see
+// the reads and fetches the program makes.  A block can come out empty; the caller then
+// interprets the instruction at start.
+void MOS6502::buildBlock(const Word start, block& b) {
+	auto decodable = [&](const Word address) {
+		return !mem.isObserved(address, Memory<Word, Byte>::Observer::Fetch) && !mem.isDevice(address);
+	};
+
+	auto markCode = [&](const Word address) {
+		mem.markCodePage(address);
+		_codeBytes[address] = true;
+		b.pages[1] = address >> 8;
+	};
+
+	b.instructions.clear();
+	b.pages = { Byte(start >> 8), Byte(start >> 8) };
+	markCode(start);
+
+	uint32_t address = start;
+	while (b.instructions.size() < MAX_BLOCK_INSTRUCTIONS) {
+		if (!decodable(address))
+			break;
+
+		const Byte opcode = mem.Peek(address);
+		const auto& ins = _instructions[opcode];
+		if (ins.opfn == nullptr || address + ins.bytes > LAST_ADDRESS + 1)
+			break;
+
+		decodedInstruction d = { ins.opfn, Word(address), opcode, ins.cycles, { 0, 0 } };
+		bool decoded = true;
+		for (Byte i = 1; i < ins.bytes; i++) {
+			if (!decodable(address + i)) {
+				decoded = false;
+				break;
+			}
+			d.operands[i - 1] = mem.Peek(address + i);
+		}
+		if (!decoded)
+			break;
+
+		for (Byte i = 0; i < ins.bytes; i++)
+			markCode(address + i);
+
+		b.instructions.push_back(d);
+		address += ins.bytes;
+
+		if (ins.flags & InstructionFlags::EndsBlock)
+			break;
+	}
+
+	b.generations = { _pageGenerations[b.pages[0]], _pageGenerations[b.pages[1]] };
+}
+
+// Run instructions from the block at PC, leaving as soon as execution doesn't follow the block,
+// code has been written, or anything needs the run loop's attention.  The first instruction has
+// already been cleared to run by the caller.
+void MOS6502::executeBlock(uint64_t& cyclesUsed, uint64_t& instructions, const uint64_t cycleBudget, const uint64_t instructionBudget) {
+	const block& b = getBlock(PC);
+
+	if (b.instructions.empty()) {
+		dispatchInstruction();
+		cyclesUsed += _cycles;
+		instructions++;
+		return;
+	}
+
+	blockRun run = { cyclesUsed, instructions, cycleBudget, instructionBudget, _codeGeneration,
+		b.instructions.data() + b.instructions.size() };
+	for (auto ins = b.instructions.data(); executeDecoded(ins, run); ins++)
+		;
+
+	cyclesUsed = run.cyclesUsed;
+	instructions = run.instructions;
+}
+
+// Execute one instruction from a block.  Returns true if the next instruction in the block can
+// follow it.
+bool MOS6502::executeDecoded(const decodedInstruction* ins, blockRun& run) {
+	// Account for the opcode fetch, then let the handler read its operands from the block
+	PC++;
+	_cycles++;
+	_operands = ins->operands;
+	_expectedCyclesToUse = ins->cycles;
+
+	(this->*ins->opfn)(ins->opcode);
+	_operands = nullptr;
+	checkForLoop(ins->address);
+
+	run.cyclesUsed += _cycles;
+	run.instructions++;
+
+	const auto next = ins + 1;
+	if (next == run.end || PC != next->address || run.generation != _codeGeneration || actionableEvents() ||
+		_stopAddresses[PC] || run.cyclesUsed >= run.cycleBudget || run.instructions >= run.instructionBudget)
+		return false;
+
+	_cycles = 0;
+	return true;
+}
+
+// Called by memory for any change to a page we've decoded code from
+void MOS6502::codeChanged(const Word address) {
+	if (!_codeBytes[address])
+		return;
+
+	// Retire every block built from this page.  Its code bytes are marked again as blocks are rebuilt.
+	const Word page = address >> 8;
+	_pageGenerations[page]++;
+	_codeGeneration++;
+
+	for (uint32_t a = page << 8; a <= uint32_t(page << 8 | 0xff); a++)
+		_codeBytes[a] = false;
+}
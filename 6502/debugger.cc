@@ -57,6 +57,8 @@ void Debugger::deleteBreakpoint(const Word bp) {
 		return;
 	}
 	
+	_cpu.updateStopAddress(bp);
+
 	fmt::print("Removed breakpoint at {:04x}", bp);
 	auto label = addressLabel(bp);
 	if (!label.empty()) 
@@ -70,6 +72,7 @@ void Debugger::addBreakpoint(const Word bp) {
 		return;
 	}
 	breakpoints.insert(bp);
+	_cpu.updateStopAddress(bp);
 
 	fmt::print("Set breakpoint at {:04x}", bp);
 	auto label = addressLabel(bp);
@@ -79,7 +82,10 @@ void Debugger::addBreakpoint(const Word bp) {
 }
 
 void Debugger::deleteAllBreakpoints() { 
+	auto removed = std::move(breakpoints);
 	breakpoints.clear();
+	for (const auto bp : removed)
+		_cpu.updateStopAddress(bp);
 }
 
 //////////
@@ -242,10 +248,10 @@ bool Debugger::loadHexFile(const std::string& filename) {
 		lineStream >> std::hex >> address >> colon; // Read the address.
 		
 		uint64_t element;
-		while (lineStream >> std::hex >> element) {
-			_cpu.mem[address] = static_cast<Byte>(element);
-			address++;
-		}
+		std::vector<Byte> data;
+		while (lineStream >> std::hex >> element)
+			data.push_back(static_cast<Byte>(element));
+		_cpu.mem.writeBlock(address, data);
 	}
 
 	return true;
@@ -269,12 +275,11 @@ bool Debugger::saveToHexFile(const std::string& filename, const std::vector<std:
 		}
 
 		std::string out;
-		for (Word i = startAddress; i <= endAddress; i += 16) {
-			out = fmt::format("{:0>4X}: ", i);
-			for (Word j = 0; j < 16 && (i + j) <= endAddress; ++j) {
-				Byte element = _cpu.mem[i+j];
-				out += fmt::format("{:02X} ", element);
-			}
+		const auto data = _cpu.mem.readBlock(startAddress, endAddress);
+		for (uint32_t i = 0; i < data.size(); i += 16) {
+			out = fmt::format("{:0>4X}: ", startAddress + i);
+			for (uint32_t j = i; j < i + 16 && j < data.size(); ++j)
+				out += fmt::format("{:02X} ", data[j]);
 			outFile << out << '\n';
 		}
 	}
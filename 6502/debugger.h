@@ -110,6 +110,8 @@ private:
 	bool clockCmd(std::string&);
 	bool loadScriptCmd(std::string&);
 	bool savememCmd(std::string&);
+	bool snapshotCmd(std::string&);
+	bool restoreCmd(std::string&);
 	bool loadhexCmd(std::string&);
 
 	// Hex file
@@ -172,6 +172,14 @@ std::vector<Debugger::debugCommand> Debugger::setupDebugCommands() {
 		{ "save",      "",   &Debugger::savememCmd, false, 
 		  "Save memory in Wozmon format" 
 		},
+		{ "snapshot",  "",   &Debugger::snapshotCmd, true, 
+		  "'snapshot <file>' saves the whole machine (CPU, memory "
+		  "and devices) to 'file'"
+		},
+		{ "restore",   "",   &Debugger::restoreCmd, true, 
+		  "'restore <file>' restores the machine from a snapshot "
+		  "saved with 'snapshot'"
+		},
 		{ "state",     "p",  &Debugger::cpustateCmd, false,
 		  "Show current CPU state"},
 		{ "autostate", "a",  &Debugger::autostateCmd, false,
@@ -212,7 +220,7 @@ std::vector<Debugger::debugCommand> Debugger::setupDebugCommands() {
 		  "Display the current memory map"
 		},
 		{ "find",      "f",  &Debugger::findCmd, false, 
-		  "Find a string sequence in memory, with optional filter"
+		  "Find string sequences in memory, with optional filter.  Separate sequences with '|', use '?' to match any byte, and '\\?' to match a '?'"
 		},
 		{ "exception", "",   &Debugger::exceptionCmd, false, 
 		  "Enter debugger on CPU exception"
@@ -337,6 +345,38 @@ bool Debugger::savememCmd([[maybe_unused]] std::string& line) {
 	return saveToHexFile(filename, ranges);
 }
 
+bool Debugger::snapshotCmd(std::string& line) {
+	line = stripLeadingSpaces(line);
+	line = stripTrailingSpaces(line);
+
+	try {
+		_cpu.saveSnapshot(line);
+		fmt::print("Saved snapshot {}\n", line);
+	}
+	catch (std::exception &e) {
+		fmt::print("Snapshot failed: {}\n", e.what());
+		return false;
+	}
+
+	return true;
+}
+
+bool Debugger::restoreCmd(std::string& line) {
+	line = stripLeadingSpaces(line);
+	line = stripTrailingSpaces(line);
+
+	try {
+		_cpu.restoreSnapshot(line);
+		fmt::print("Restored snapshot {}\n", line);
+	}
+	catch (std::exception &e) {
+		fmt::print("Restore failed: {}\n", e.what());
+		return false;
+	}
+
+	return true;
+}
+
 bool Debugger::stackCmd([[maybe_unused]] std::string& line) {
 	_cpu.Stack();
 	return true;
@@ -484,7 +524,7 @@ bool Debugger::memdumpCmd(std::string& line) {
         value = (Word) std::stoul(matches[5], nullptr, 16);
 		if (calculateAddress(matches, addr1, addr2, true) &&
 			rangeCheckAddr(addr1) && rangeCheckAddr(addr2) && rangeCheckValue(value)) {
-				_cpu.mem.assign(addr1, addr2, (Byte) value);
+				_cpu.mem.fill(addr1, addr2, (Byte) value);
 			return true;
 		}
 	} 
@@ -554,11 +594,11 @@ bool Debugger::setCmd(std::string& line) {
 	else if (reg == "SP")
 		_cpu.SP = static_cast<Byte>(value);
 	else if (reg == "PS")
-		_cpu.PS = static_cast<Byte>(value);
+		_cpu.setStatusRegister(static_cast<Byte>(value));
 	else if (reg == "C")
 		_cpu.Flags.C = flipFlag ? !_cpu.Flags.C : static_cast<bool>(value);
 	else if (reg == "Z")
-		_cpu.Flags.Z = flipFlag ? !_cpu.Flags.Z : static_cast<bool>(value);
+		_cpu.setFlagZByValue((flipFlag ? !_cpu.flagZ() : static_cast<bool>(value)) ? 0 : 1);
 	else if (reg == "I")
 		_cpu.Flags.I = flipFlag ? !_cpu.Flags.I : static_cast<bool>(value);
 	else if (reg == "D")
@@ -568,7 +608,7 @@ bool Debugger::setCmd(std::string& line) {
 	else if (reg == "V")
 		_cpu.Flags.V = flipFlag ? !_cpu.Flags.V : static_cast<bool>(value);
 	else if (reg == "N")
-		_cpu.Flags.N = flipFlag ? !_cpu.Flags.N : static_cast<bool>(value);
+		_cpu.setFlagNByValue((flipFlag ? !_cpu.flagN() : static_cast<bool>(value)) ? 0x80 : 0);
 	else {
 		fmt::print("No register or status flag '{}'\n", reg);
 		return false;
@@ -590,7 +630,7 @@ bool Debugger::continueCmd([[maybe_unused]] std::string& line) {
 		fmt::print("CPU Exception hit; can't continue.  Reset CPU to clear.\n");
 		return false;
 	}
-	_cpu._debugMode = false;
+	_cpu.setDebugMode(false);
 	return true;
 }
 
@@ -730,15 +770,26 @@ bool Debugger::findCmd(std::string& line) {
 		}
 	} 
 
-	auto locations = _cpu.mem.find(sequence, filter);
+	std::vector<MemorySearch<Byte>::pattern> patterns;
+	std::vector<std::string> names;
+	while (!sequence.empty()) {
+		names.push_back(split(sequence, "|"));
+		patterns.push_back(MemorySearch<Byte>::fromString(names.back(), '?'));
+	}
+
+	const auto locations = _cpu.mem.search(MemorySearch<Byte>(patterns, filter));
 	if (locations.empty()) {
 		fmt::print("Sequence not found\n");
 		return true;
 	}
 
 	fmt::print("Sequence found at addresses:\n");
-	for (const auto& addr : locations) 
-		fmt::print(" {:04x}\n", addr);
+	for (const auto& location : locations) {
+		if (patterns.size() > 1)
+			fmt::print(" {:04x} {}\n", location.offset, names[location.patternIndex]);
+		else
+			fmt::print(" {:04x}\n", location.offset);
+	}
 
 	return true;
 }
@@ -818,7 +869,7 @@ void Debugger::executeDebug() {
 	getReadline(line);
 	executeDebuggerCmd(line);
 
-	if (!_cpu._debugMode) { 
+	if (!_cpu.isInDebugMode()) { 
 		fmt::print("Exiting debugger\n");
 		header = false;
 	}
@@ -27,6 +27,43 @@
 
 // Don't use read{Byte,Word}AtPC() in the disassembler, as that increments the Program Counter.  
 
+// Argument decoding for Rockwell R65C02 specific instructions (BBRn abd BBSn).  These instruction mnemonics don't 
+// conform with the rest of the 65C02 & 6502 instructions.
+void MOS6502::decodeRockwellArgs(Word& dPC, std::string& disassembly, std::string& opcodes, std::string& address) {
+
+	std::string zplabel, abslabel, zpaddr_str, reladdr_str, absaddr_str;
+	auto zpaddr  = readByte(dPC++);
+	auto reladdr = readByte(dPC++);
+	Word absaddr = PC + SByte(reladdr);
+
+	zpaddr_str= fmt::format("${:02x}", zpaddr);
+	zplabel = debugger.addressLabel(zpaddr);	
+
+	if (!zplabel.empty()) {
+		disassembly = zplabel;
+		address = zpaddr;
+	} else { 
+		disassembly = zpaddr_str;
+		address = "";
+	} 
+
+	reladdr_str = fmt::format("${:02x}", reladdr);
+	abslabel = debugger.addressLabel(absaddr);
+	absaddr_str = fmt::format("{:04x}", absaddr);
+
+	if (!abslabel.empty()) {
+		disassembly += "," + zplabel;
+		address += "," + abslabel;
+	} else { 
+		disassembly += "," + reladdr_str;
+		address = absaddr_str;
+	} 
+
+	opcodes += fmt::format("{:02x} {:02x} ", zpaddr, reladdr);
+	return;
+}
+
+
 void MOS6502::decodeArgs(Word& dPC, const bool atPC, const Byte opcode, std::string& disassembly, 
 					     std::string& opcodes, std::string& address, std::string& computedAddr) {
 	auto mode = getInstructionAddressingMode(opcode);
@@ -37,6 +74,12 @@ void MOS6502::decodeArgs(Word& dPC, const bool atPC, const Byte opcode, std::str
 
 	// Note: if atPC is true, then the registers are valid to compute absolute indexed or Zero Page indexed addresses.
 
+	// Rockwell R65C02 BBRn and BBSn are the only three byte relative instructions
+	if (mode == AddressingMode::Relative && _instructions[opcode].bytes == 3) {
+		decodeRockwellArgs(dPC, disassembly, opcodes, address);
+		return;
+	}
+
 	switch (mode) {
 	case AddressingMode::Implied:
 		break;
@@ -234,6 +277,43 @@ void MOS6502::decodeArgs(Word& dPC, const bool atPC, const Byte opcode, std::str
 		}
 		break;
 	
+	// 65C02 modes
+	case AddressingMode::ZeroPageIndirect:
+		byteval = readByte(dPC++);
+		wordval = readWord(byteval);
+		label = debugger.addressLabelSearch(wordval);
+		addr = fmt::format("(${:02})", byteval);
+
+		if (!label.empty()) {
+			disassembly = label;
+			address = addr;
+		} else {
+			disassembly = addr;
+			address = "";
+		}
+		opcodes += fmt::format("{:02x} ", byteval);
+		if (atPC) 
+			computedAddr = fmt::format("{:02x}", byteval);
+		break;
+
+	case AddressingMode::AbsoluteIndexedIndirect:
+		wordval = readWord(dPC++);
+		label = debugger.addressLabelSearch(wordval);
+		addr = fmt::format("(${:04x}", wordval);
+		if (!label.empty()) {
+			disassembly = label;
+			address = addr;
+		} else {
+			disassembly = addr;
+			address = "";
+		}
+		disassembly += ",X";
+		opcodes += fmt::format("{:02x} {:02x}", wordval & 0xff, (wordval >> 8) & 0xff);
+		if (atPC) 
+			computedAddr = fmt::format("${:04x}", wordval + X);
+
+		break;
+
 	default:
 		disassembly += fmt::format("[Invalid addressing mode]");
 	}
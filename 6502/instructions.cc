@@ -17,35 +17,14 @@
 // this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <6502.h>
+#include <instructions.h>
 
 //////////
 // Helper functions
 
-// The shift and rotate instructions (ASL, LSR, ROL, ROR) can operate on A implicitly, or on 
-// data in memory.  These helpers make that a bit easier.
-void MOS6502::getAorData(Byte& data, const Byte opcode, Word& address) {
-	bool accumulator = instructionIsAddressingMode(opcode, AddressingMode::Accumulator);
-
-	if (accumulator)
-		data = A;
-	else {
-		address = getAddress(opcode);
-		data = readByte(address);
-	}
-}
-
-void MOS6502::putAorData(const Byte data, const Byte opcode, Word address) {
-	bool accumulator = instructionIsAddressingMode(opcode, AddressingMode::Accumulator);
-
-	if (accumulator)
-		A = data;
-	else 
-		writeByte(address, data);
-}
-
 // Set PC to @address if @condition is true
 void MOS6502::doBranch(const bool condition, const Byte opcode) {
-	Word address = getAddress(opcode);
+	Word address = getAddress<AddressingMode::Relative>(opcode);
 
 	if (condition) {
 		_cycles++;	// Branch taken
@@ -60,67 +39,94 @@ void MOS6502::doBranch(const bool condition, const Byte opcode) {
 	}
 }
 
-// BCD addition and subtraction functions.
+// BCD addition and subtraction
+//   Results for every (carry, A, operand) are worked out at compile time.  Each entry holds the
+//   result in the low byte, the carry in bit 8 and, for addition, overflow in bit 9.
 // See:
 // https://www.electrical4u.com/bcd-or-binary-coded-decimal-bcd-conversion-addition-subtraction/
-void MOS6502::bcdADC(const Byte operand) {
-	Byte addend, carry, a_low;
-	int answer;
-
-	addend = A;
-	carry = Flags.C;
-
-	// Low nibble first
-	a_low = static_cast<Byte>((addend & 0x0f) + (operand & 0x0f) + carry);
-	if (a_low >= 0x0a) 
-		a_low = ((a_low + 0x06) & 0x0f) + 0x10;
-
-	// Then high nibble
-	answer = (addend & 0xf0) + (operand & 0xf0);
-	
-	// Then combine them
-	answer += a_low;
-
-	// Then turn the result into BCD
-	if (answer >= 0xa0) 
-		answer += 0x60;
-	
-	A = static_cast<Word>(answer & 0xff);
-	
-	setFlagNByValue(A);
-	setFlagZByValue(A);
-	Flags.C = (answer >= 0x100);
-	Flags.V = (answer < -128) || (answer > 127);
-}
+namespace {
+	using bcdTable_t = std::array<uint16_t, 2 * 256 * 256>;
 
-void MOS6502::bcdSBC(const Byte subtrahend) {
-	SByte op_l;
-	int operand;
-	Byte carry;
+	constexpr uint16_t BCD_CARRY    = 1 << 8;
+	constexpr uint16_t BCD_OVERFLOW = 1 << 9;
 
-	operand = A;
-	carry = (Flags.C == 0);
+	constexpr size_t bcdIndex(const bool carry, const Byte a, const Byte operand) {
+		return (size_t(carry) << 16) | (size_t(a) << 8) | operand;
+	}
+
+	constexpr uint16_t bcdAdd(const Byte addend, const Byte operand, const bool carry) {
+		// Low nibble first
+		Byte a_low = static_cast<Byte>((addend & 0x0f) + (operand & 0x0f) + carry);
+		if (a_low >= 0x0a)
+			a_low = ((a_low + 0x06) & 0x0f) + 0x10;
+
+		// Then high nibble, then combine them
+		int answer = (addend & 0xf0) + (operand & 0xf0) + a_low;
+
+		// Then turn the result into BCD
+		if (answer >= 0xa0)
+			answer += 0x60;
+
+		uint16_t entry = answer & 0xff;
+		if (answer >= 0x100)
+			entry |= BCD_CARRY;
+		if ((answer < -128) || (answer > 127))
+			entry |= BCD_OVERFLOW;
+		return entry;
+	}
 
-	// Low nibble first
-	op_l = static_cast<SByte>((operand & 0x0f) - (subtrahend & 0x0f) - carry);
-	if (op_l < 0) 
-		op_l = ((op_l - 0x06) & 0x0f) - 0x10;
-					
-	// Then high nibble
-	operand = (operand & 0xf0) - (subtrahend & 0xf0);
+	constexpr uint16_t bcdSubtract(const Byte minuend, const Byte subtrahend, const bool carry) {
+		const Byte borrow = !carry;
 
-	// Then combine them
-	operand += op_l;
+		// Low nibble first
+		SByte op_l = static_cast<SByte>((minuend & 0x0f) - (subtrahend & 0x0f) - borrow);
+		if (op_l < 0)
+			op_l = static_cast<SByte>(((op_l - 0x06) & 0x0f) - 0x10);
 
-	// Then turn the result into BCD
-	if (operand < 0) 
-		operand -= 0x60;
+		// Then high nibble, then combine them
+		int operand = (minuend & 0xf0) - (subtrahend & 0xf0) + op_l;
 
-	A = static_cast<Byte>(operand & 0xff);
+		// Then turn the result into BCD
+		if (operand < 0)
+			operand -= 0x60;
+
+		uint16_t entry = operand & 0xff;
+		if (operand >= 0)
+			entry |= BCD_CARRY;
+		return entry;
+	}
+
+	template<uint16_t (*fn)(Byte, Byte, bool)>
+	constexpr bcdTable_t makeBCDTable() {
+		bcdTable_t table{};
+		for (int carry = 0; carry < 2; carry++)
+			for (int a = 0; a < 256; a++)
+				for (int operand = 0; operand < 256; operand++)
+					table[bcdIndex(carry, Byte(a), Byte(operand))] = fn(Byte(a), Byte(operand), carry);
+		return table;
+	}
+
+	constexpr bcdTable_t bcdADCTable = makeBCDTable<bcdAdd>();
+	constexpr bcdTable_t bcdSBCTable = makeBCDTable<bcdSubtract>();
+}
+
+void MOS6502::bcdADC(const Byte operand) {
+	const uint16_t entry = bcdADCTable[bcdIndex(Flags.C, A, operand)];
+
+	A = static_cast<Byte>(entry);
+	setFlagNByValue(A);
+	setFlagZByValue(A);
+	Flags.C = (entry & BCD_CARRY) != 0;
+	Flags.V = (entry & BCD_OVERFLOW) != 0;
+}
+
+void MOS6502::bcdSBC(const Byte subtrahend) {
+	const uint16_t entry = bcdSBCTable[bcdIndex(Flags.C, A, subtrahend)];
 
+	A = static_cast<Byte>(entry);
 	setFlagZByValue(A);
 	setFlagNByValue(A);
-	Flags.C = (operand >= 0);
+	Flags.C = (entry & BCD_CARRY) != 0;
 }
 
 // A = A + operand + Flags.C
@@ -140,42 +146,6 @@ void MOS6502::doADC(const Byte operand) {
 ////
 // CPU Instructions
 
-// ADC
-void MOS6502::ins_adc(const Byte opcode) {
-	Byte operand = getData(opcode);
-	
-	if (Flags.D) {
-		bcdADC(operand);
-	} else { 
-		doADC(operand);
-	}
-}
-
-// AND
-void MOS6502::ins_and(const Byte opcode) {
-	Byte data = getData(opcode);
-	A &= data;
-	setFlagZByValue(A);
-	setFlagNByValue(A);
-}
-
-// ASL
-void MOS6502::ins_asl(const Byte opcode) {
-	Word address;
-	Byte data;
-	
-	getAorData(data, opcode, address);
-
-	Flags.C = isNegative(data);
-	data = data << 1;
-	setFlagNByValue(data);
-	setFlagZByValue(data);
-
-	putAorData(data, opcode, address);
-	
-	_cycles++;
-}
-
 // BCC
 void MOS6502::ins_bcc(const Byte opcode) {
 	doBranch(!Flags.C, opcode);
@@ -188,33 +158,22 @@ void MOS6502::ins_bcs(const Byte opcode) {
 
 // BEQ
 void MOS6502::ins_beq(const Byte opcode) {
-	doBranch(Flags.Z, opcode);
-}
-
-// BIT
-void MOS6502::ins_bit(const Byte opcode) {
-	Byte data;
-
-	data = getData(opcode);
-	setFlagZByValue(A & data);
-	setFlagNByValue(data);
-	// Copy bit 6 of the value into the V flag
-	Flags.V = (data & (1 << 6)) != 0;
+	doBranch(flagZ(), opcode);
 }
 
 // BMI
 void MOS6502::ins_bmi(const Byte opcode) {
-	doBranch(Flags.N, opcode);
+	doBranch(flagN(), opcode);
 }
 
 // BNE
 void MOS6502::ins_bne(const Byte opcode) {
-	doBranch(!Flags.Z, opcode);
+	doBranch(!flagZ(), opcode);
 }
 
 // BPL
 void MOS6502::ins_bpl(const Byte opcode) {
-	doBranch(!Flags.N, opcode);
+	doBranch(!flagN(), opcode);
 }
 
 // BRK
@@ -262,53 +221,6 @@ void MOS6502::ins_clv([[maybe_unused]] const Byte opcode) {
 	_cycles++;		// Single byte instruction
 }
 
-// CMP
-void MOS6502::ins_cmp(const Byte opcode) {
-	Byte data = getData(opcode);
-
-	Flags.C = A >= data;
-	Flags.Z = A == data;
-
-	Byte result = A - data;
-	setFlagNByValue(result);
-}
-
-// CPX
-void MOS6502::ins_cpx(const Byte opcode) {
-	Byte data = getData(opcode);
-
-	Flags.C = X >= data;
-	Flags.Z = X == data;
-
-	Byte result = X - data;
-	setFlagNByValue(result);
-}
-
-// CPY
-void MOS6502::ins_cpy(const Byte opcode) {
-	Byte data = getData(opcode);
-	
-	Flags.C = Y >= data;
-	Flags.Z = Y == data;
-
-	Byte result = Y - data;
-	setFlagNByValue(result);
-}
-
-// DEC
-void MOS6502::ins_dec(const Byte opcode) {
-	Word address;
-	Byte data;
-
-	address = getAddress(opcode);
-	data = readByte(address);
-	data--;
-	writeByte(address, data);
-	setFlagZByValue(data);
-	setFlagNByValue(data);
-	_cycles++;
-}
-
 // DEX
 void MOS6502::ins_dex([[maybe_unused]] const Byte opcode) {
 	X--;
@@ -325,30 +237,6 @@ void MOS6502::ins_dey([[maybe_unused]] const Byte opcode) {
 	_cycles++;
 }
 
-// EOR
-void MOS6502::ins_eor(const Byte opcode) {
-	Byte data;
-
-	data = getData(opcode);
-	A ^= data;
-	setFlagZByValue(A);
-	setFlagNByValue(A);
-}
-
-// INC
-void MOS6502::ins_inc(const Byte opcode) {
-	Word address;
-	Byte data;
-
-	address = getAddress(opcode);
-	data = readByte(address);
-	data++;
-	writeByte(address, data);
-	setFlagZByValue(data);
-	setFlagNByValue(data);
-	_cycles++;
-}
-
 // INX
 void MOS6502::ins_inx([[maybe_unused]] const Byte opcode) {
 	X++;
@@ -365,83 +253,21 @@ void MOS6502::ins_iny([[maybe_unused]] const Byte opcode) {
 	_cycles++;
 }
 
-// JMP
-void MOS6502::ins_jmp(const Byte opcode) {
-	Word address = readWord(PC);
-	
-	if (instructionIsAddressingMode(opcode, AddressingMode::Indirect)) {
-		if ((address & 0xff) == 0xff) { // implement the JMP Indirect bug
-			Byte lsb = readByte(address);
-			Byte msb = readByte(address & 0xff00);
-			address = (msb << 8) | lsb;
-		} else {
-			address = readWord(address);
-		}
-	} 
-
-	PC = address;
-}
-
 // JSR
 void MOS6502::ins_jsr([[maybe_unused]] const Byte opcode) {
 	debugger.addBacktrace(PC - 1);
 
 	pushWord(PC + 1);
-	PC = readWord(PC);
+	PC = readWordAtPC();
 	_cycles += 2;
 }
 
-// LDA
-void MOS6502::ins_lda(const Byte opcode) {
-	A = getData(opcode);
-	setFlagZByValue(A);
-	setFlagNByValue(A);
-}
-
-// LDX
-void MOS6502::ins_ldx(const Byte opcode) {
-	X = getData(opcode);
-	setFlagZByValue(X);
-	setFlagNByValue(X);
-}
-
-// LDY
-void MOS6502::ins_ldy(const Byte opcode) {
-	Y = getData(opcode);
-	setFlagZByValue(Y);
-	setFlagNByValue(Y);
-}
-
-// LSR
-void MOS6502::ins_lsr(const Byte opcode) {
-	Word address;
-	Byte data;
-
-	getAorData(data, opcode, address);
-	
-	Flags.C = (data & 1); // Bit 1 of data becomes Carry
-	data = data >> 1;
-	setFlagZByValue(data);
-	setFlagNByValue(data);
-	
-	putAorData(data, opcode, address);
-
-	_cycles++;
-}
-
 // NOP
 void MOS6502::ins_nop([[maybe_unused]] const Byte opcode) {
 	// NOP, like all single byte instructions, takes two cycles.
 	_cycles++;
 }
 
-// ORA
-void MOS6502::ins_ora(const Byte opcode) {
-	A |= getData(opcode);
-	setFlagNByValue(A);
-	setFlagZByValue(A);
-}
-
 // PHA
 void MOS6502::ins_pha([[maybe_unused]] const Byte opcode) {
 	push(A);
@@ -468,44 +294,6 @@ void MOS6502::ins_plp([[maybe_unused]] const Byte opcode) {
 	_cycles += 2;
 }
 
-// ROL
-void MOS6502::ins_rol(const Byte opcode) {
-	Word address;
-	Byte data, oldCarryFlag;
-	
-	getAorData(data, opcode, address);
-	oldCarryFlag = Flags.C;
-	Flags.C = isNegative(data);
-
-	data = (data << 1) | oldCarryFlag; // Carry becomes bit 1 of result
-
-	setFlagZByValue(data);
-	setFlagNByValue(data);
-
-	putAorData(data, opcode, address);
-
-	_cycles++;
-}
-
-// ROR
-void MOS6502::ins_ror(const Byte opcode) {
-	Word address;
-	Byte data, newCarryFlag;
-	
-	getAorData(data, opcode, address);
-
-	newCarryFlag = data & 1;
-	data = data >> 1;
-	data |=  Flags.C << 7;  // Carry bit becomes bit 7 of the result
-	setFlagNByValue(data);
-	setFlagZByValue(data);
-	Flags.C = (newCarryFlag == 1);
-
-	putAorData(data, opcode, address);
-
-	_cycles++;
-}
-
 // RTI
 void MOS6502::ins_rti([[maybe_unused]] const Byte opcode) {
 	debugger.removeBacktrace();
@@ -521,17 +309,6 @@ void MOS6502::ins_rts([[maybe_unused]] const Byte opcode) {
 	_cycles += 3;	       
 }
 
-// SBC
-void MOS6502::ins_sbc(const Byte opcode) {
-	Byte operand = getData(opcode);
-
-	if (Flags.D) {
-		bcdSBC(operand); 
-	} else {	
-		doADC(~operand);
-	}
-}
-
 // SEC
 void MOS6502::ins_sec([[maybe_unused]] const Byte opcode) {
 	Flags.C = 1;
@@ -550,29 +327,6 @@ void MOS6502::ins_sei([[maybe_unused]] const Byte opcode) {
 	_cycles++;		// Single byte instruction
 }
 
-// STA
-void MOS6502::ins_sta(const Byte opcode) {
-	Word address = getAddress(opcode);
-	writeByte(address, A);
-	
-	// All other instances of (Indirect),Y are N cycles, plus 1 if the address calculation crosses a 
-	// page boundary.  STA (Indirect),Y is 6 cycles regardless of page boundaries.  Handle this special case here.
-	if (instructionIsAddressingMode(opcode, AddressingMode::IndirectY)) 
-		_cycles++;
-}
-
-// STX
-void MOS6502::ins_stx(const Byte opcode) {
-	Word address = getAddress(opcode);
-	writeByte(address, X);
-}
-
-// STY
-void MOS6502::ins_sty(const Byte opcode) {
-	Word address = getAddress(opcode);
-	writeByte(address, Y);
-}
-
 // TAX
 void MOS6502::ins_tax([[maybe_unused]] const Byte opcode) {
 	X = A;
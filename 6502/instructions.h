@@ -0,0 +1,415 @@
+//
+// Addressing mode specialized 6502 instruction implementations
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Instructions that take a memory operand are templates on their addressing mode.  The opcode
+// map instantiates one handler per (instruction, addressing mode) pair, so the address decode
+// below is resolved at compile time and each opcode gets a straight-line implementation.
+//
+// Included by the translation units that build the instruction tables, since that is where the
+// handlers are instantiated.
+
+#pragma once
+
+#include <6502.h>
+
+//////////
+// Address decoding
+template<MOS6502::AddressingMode mode, uint8_t flags>
+Word MOS6502::getAddress([[maybe_unused]] const Byte opcode) {
+	// Implied, Accumulator, Immediate and Indirect opcodes don't decode an address; neither does
+	// JMP (Absolute,X), which handles its own indirection.
+	static_assert(mode != AddressingMode::Implied && mode != AddressingMode::Accumulator &&
+				  mode != AddressingMode::Immediate && mode != AddressingMode::Indirect &&
+				  mode != AddressingMode::AbsoluteIndexedIndirect,
+				  "Can't decode address for Implied, Accumulator, Immediate or Indirect opcode");
+
+	Word address;
+
+	// Add a cycle if a page boundary is crossed
+	[[maybe_unused]] auto updateCycles = [&](Byte reg) {
+		if constexpr ((flags & InstructionFlags::PageBoundary) != 0) {
+			if (((address + reg) >> 8) != (address >> 8)) {
+				_expectedCyclesToUse++;
+				_cycles++;
+			}
+		} else 
+			_cycles++;
+	};
+
+	// ZeroPage mode
+	if constexpr (mode == AddressingMode::ZeroPage) {
+		address = readByteAtPC();
+
+	// ZeroPage,X (with zero page wrap around)
+	} else if constexpr (mode == AddressingMode::ZeroPageX) {
+		address = static_cast<Byte>(readByteAtPC() + X);
+		_cycles++;
+
+	// ZeroPage,Y (with zero page wrap around)
+	} else if constexpr (mode == AddressingMode::ZeroPageY) {
+		address = static_cast<Byte>(readByteAtPC() + Y);
+		_cycles++;
+
+	// Relative
+	} else if constexpr (mode == AddressingMode::Relative) {
+		SByte rel = static_cast<SByte>(readByteAtPC());
+		address = static_cast<Word>(PC + rel);
+
+	// Absolute
+	} else if constexpr (mode == AddressingMode::Absolute) {
+		address = readWordAtPC();
+
+	// Absolute,X 
+	} else if constexpr (mode == AddressingMode::AbsoluteX) {
+		address = readWordAtPC();
+		updateCycles(X);
+		address += X;
+
+	// Absolute,Y 
+	} else if constexpr (mode == AddressingMode::AbsoluteY) {
+		address = readWordAtPC();
+		updateCycles(Y);
+		address += Y;
+
+	// (Indirect,X) or Indexed Indirect (with zero page wrap around)
+	} else if constexpr (mode == AddressingMode::IndirectX) {
+		address = static_cast<Byte>(readByteAtPC() + X);
+		address = readWord(address);
+		_cycles++;
+
+	// (Indirect),Y or Indirect Indexed
+	} else if constexpr (mode == AddressingMode::IndirectY) {
+		address = readByteAtPC();
+		address = readWord(address) + Y;
+
+	// (ZeroPage) - 65C02 only
+	} else if constexpr (mode == AddressingMode::ZeroPageIndirect) {
+		address = static_cast<Word>(readByteAtPC());
+		address = readWord(address);
+	}
+
+	return address;
+}
+
+template<MOS6502::AddressingMode mode, uint8_t flags>
+Byte MOS6502::getData(const Byte opcode) {
+	if constexpr (mode == AddressingMode::Immediate) 
+		return readByteAtPC();
+	else 
+		return readByte(getAddress<mode, flags>(opcode));
+}
+
+//////////
+// Helper functions
+
+// The shift and rotate instructions (ASL, LSR, ROL, ROR) can operate on A implicitly, or on 
+// data in memory.  These helpers make that a bit easier.
+template<MOS6502::AddressingMode mode>
+void MOS6502::getAorData(Byte& data, const Byte opcode, Word& address) {
+	if constexpr (mode == AddressingMode::Accumulator) {
+		data = A;
+	} else {
+		address = getAddress<mode>(opcode);
+		data = readByte(address);
+	}
+}
+
+template<MOS6502::AddressingMode mode>
+void MOS6502::putAorData(const Byte data, [[maybe_unused]] const Word address) {
+	if constexpr (mode == AddressingMode::Accumulator)
+		A = data;
+	else 
+		writeByte(address, data);
+}
+
+////
+// CPU Instructions
+
+// ADC
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_adc(const Byte opcode) {
+	Byte operand = getData<mode, flags>(opcode);
+	
+	if (Flags.D) {
+		bcdADC(operand);
+	} else { 
+		doADC(operand);
+	}
+}
+
+// AND
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_and(const Byte opcode) {
+	Byte data = getData<mode, flags>(opcode);
+	A &= data;
+	setFlagZByValue(A);
+	setFlagNByValue(A);
+}
+
+// ASL
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_asl(const Byte opcode) {
+	Word address = 0;
+	Byte data;
+	
+	getAorData<mode>(data, opcode, address);
+
+	Flags.C = isNegative(data);
+	data = data << 1;
+	setFlagNByValue(data);
+	setFlagZByValue(data);
+
+	putAorData<mode>(data, address);
+	
+	_cycles++;
+}
+
+// BIT
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_bit(const Byte opcode) {
+	Byte data;
+
+	data = getData<mode>(opcode);
+	setFlagZByValue(A & data);
+	setFlagNByValue(data);
+	// Copy bit 6 of the value into the V flag
+	Flags.V = (data & (1 << 6)) != 0;
+}
+
+// CMP
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_cmp(const Byte opcode) {
+	Byte data = getData<mode, flags>(opcode);
+
+	Flags.C = A >= data;
+
+	Byte result = A - data;
+	setFlagZByValue(result);
+	setFlagNByValue(result);
+}
+
+// CPX
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_cpx(const Byte opcode) {
+	Byte data = getData<mode>(opcode);
+
+	Flags.C = X >= data;
+
+	Byte result = X - data;
+	setFlagZByValue(result);
+	setFlagNByValue(result);
+}
+
+// CPY
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_cpy(const Byte opcode) {
+	Byte data = getData<mode>(opcode);
+	
+	Flags.C = Y >= data;
+
+	Byte result = Y - data;
+	setFlagZByValue(result);
+	setFlagNByValue(result);
+}
+
+// DEC
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_dec(const Byte opcode) {
+	Word address;
+	Byte data;
+
+	address = getAddress<mode>(opcode);
+	data = readByte(address);
+	data--;
+	writeByte(address, data);
+	setFlagZByValue(data);
+	setFlagNByValue(data);
+	_cycles++;
+}
+
+// EOR
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_eor(const Byte opcode) {
+	Byte data;
+
+	data = getData<mode, flags>(opcode);
+	A ^= data;
+	setFlagZByValue(A);
+	setFlagNByValue(A);
+}
+
+// INC
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_inc(const Byte opcode) {
+	Word address;
+	Byte data;
+
+	address = getAddress<mode>(opcode);
+	data = readByte(address);
+	data++;
+	writeByte(address, data);
+	setFlagZByValue(data);
+	setFlagNByValue(data);
+	_cycles++;
+}
+
+// JMP
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_jmp([[maybe_unused]] const Byte opcode) {
+	Word address = readWordAtPC();
+	
+	if constexpr (mode == AddressingMode::Indirect) {
+		if ((address & 0xff) == 0xff) { // implement the JMP Indirect bug
+			Byte lsb = readByte(address);
+			Byte msb = readByte(address & 0xff00);
+			address = (msb << 8) | lsb;
+		} else {
+			address = readWord(address);
+		}
+	} 
+
+	PC = address;
+}
+
+// LDA
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_lda(const Byte opcode) {
+	A = getData<mode, flags>(opcode);
+	setFlagZByValue(A);
+	setFlagNByValue(A);
+}
+
+// LDX
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_ldx(const Byte opcode) {
+	X = getData<mode, flags>(opcode);
+	setFlagZByValue(X);
+	setFlagNByValue(X);
+}
+
+// LDY
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_ldy(const Byte opcode) {
+	Y = getData<mode, flags>(opcode);
+	setFlagZByValue(Y);
+	setFlagNByValue(Y);
+}
+
+// LSR
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_lsr(const Byte opcode) {
+	Word address = 0;
+	Byte data;
+
+	getAorData<mode>(data, opcode, address);
+	
+	Flags.C = (data & 1); // Bit 1 of data becomes Carry
+	data = data >> 1;
+	setFlagZByValue(data);
+	setFlagNByValue(data);
+	
+	putAorData<mode>(data, address);
+
+	_cycles++;
+}
+
+// ORA
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_ora(const Byte opcode) {
+	A |= getData<mode, flags>(opcode);
+	setFlagNByValue(A);
+	setFlagZByValue(A);
+}
+
+// ROL
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_rol(const Byte opcode) {
+	Word address = 0;
+	Byte data, oldCarryFlag;
+	
+	getAorData<mode>(data, opcode, address);
+	oldCarryFlag = Flags.C;
+	Flags.C = isNegative(data);
+
+	data = (data << 1) | oldCarryFlag; // Carry becomes bit 1 of result
+
+	setFlagZByValue(data);
+	setFlagNByValue(data);
+
+	putAorData<mode>(data, address);
+
+	_cycles++;
+}
+
+// ROR
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_ror(const Byte opcode) {
+	Word address = 0;
+	Byte data, newCarryFlag;
+	
+	getAorData<mode>(data, opcode, address);
+
+	newCarryFlag = data & 1;
+	data = data >> 1;
+	data |=  Flags.C << 7;  // Carry bit becomes bit 7 of the result
+	setFlagNByValue(data);
+	setFlagZByValue(data);
+	Flags.C = (newCarryFlag == 1);
+
+	putAorData<mode>(data, address);
+
+	_cycles++;
+}
+
+// SBC
+template<MOS6502::AddressingMode mode, uint8_t flags>
+void MOS6502::ins_sbc(const Byte opcode) {
+	Byte operand = getData<mode, flags>(opcode);
+
+	if (Flags.D) {
+		bcdSBC(operand); 
+	} else {	
+		doADC(~operand);
+	}
+}
+
+// STA
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_sta(const Byte opcode) {
+	Word address = getAddress<mode>(opcode);
+	writeByte(address, A);
+	
+	// All other instances of (Indirect),Y are N cycles, plus 1 if the address calculation crosses a 
+	// page boundary.  STA (Indirect),Y is 6 cycles regardless of page boundaries.  Handle this special case here.
+	if constexpr (mode == AddressingMode::IndirectY) 
+		_cycles++;
+}
+
+// STX
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_stx(const Byte opcode) {
+	Word address = getAddress<mode>(opcode);
+	writeByte(address, X);
+}
+
+// STY
+template<MOS6502::AddressingMode mode>
+void MOS6502::ins_sty(const Byte opcode) {
+	Word address = getAddress<mode>(opcode);
+	writeByte(address, Y);
+}
@@ -17,6 +17,7 @@
 // this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <6502.h>
+#include <instructions.h>
 
 // The instructions.  Flags field provides information about any special
 // handling the instruction requires.  For the 6502, the flags are:
@@ -26,467 +27,485 @@
 //  - InstructionFlags::PageBoundary: Add two cycles if an instruction causes a read from
 //                                    an address on an adjacent page, specifically indexed addressing modes.
 //
+//  - InstructionFlags::EndsBlock: The instruction doesn't fall through to the next one, so it ends a
+//                                 pre-decoded block (jumps, subroutine calls and returns, and brk).
+//
 // See http://www.6502.org/users/obelisk/6502/addressing.html for more
 // information.
 
-const MOS6502::_instructionMap_t MOS6502::setupInstructionMap() { 
-	return  {
+// Place each {opcode, instruction} pair into its slot in the table.
+void MOS6502::addInstructions(_instructionMap_t& map, const _instructionList_t instructions) {
+	for (const auto& [opcode, ins] : instructions)
+		map[opcode] = ins;
+}
+
+const MOS6502::_instructionMap_t& MOS6502::instructionMap() {
+	static const _instructionMap_t map = setupInstructionMap();
+	return map;
+}
+
+MOS6502::_instructionMap_t MOS6502::setupInstructionMap() { 
+	_instructionMap_t map{};
+
+	addInstructions(map, {
 		// The table below is formatted as follows:
 		// { Opcode, 
 		//   {"name", AddressingMode, ByteLength, CyclesUsed, Flags, Function pointer for instruction}}
-		{ Opcodes.BRK_IMP,
-		  { "brk", AddressingMode::Implied, 1, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_brk, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_IDX,
+		{ OpcodeConstants::BRK_IMP,
+		  { "brk", AddressingMode::Implied, 1, 7, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_brk}},
+		{ OpcodeConstants::ORA_IDX,
 		  { "ora", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ZP,
+		    &MOS6502::ins_ora<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::ORA_ZP,
 		  { "ora", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ZP,
+		    &MOS6502::ins_ora<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::ASL_ZP,
 		  { "asl", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.PHP_IMP,
+		    &MOS6502::ins_asl<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::PHP_IMP,
 		  { "php", AddressingMode::Implied, 1, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_php, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_IMM,
+		    &MOS6502::ins_php}},
+		{ OpcodeConstants::ORA_IMM,
 		  { "ora", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ACC,
+		    &MOS6502::ins_ora<AddressingMode::Immediate>}},
+		{ OpcodeConstants::ASL_ACC,
 		  { "asl", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ABS,
+		    &MOS6502::ins_asl<AddressingMode::Accumulator>}},
+		{ OpcodeConstants::ORA_ABS,
 		  { "ora", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ABS,
+		    &MOS6502::ins_ora<AddressingMode::Absolute>}},
+		{ OpcodeConstants::ASL_ABS,
 		  { "asl", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.BPL_REL,
+		    &MOS6502::ins_asl<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BPL_REL,
 		  { "bpl", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bpl, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_IDY,
+		    &MOS6502::ins_bpl}},
+		{ OpcodeConstants::ORA_IDY,
 		  { "ora", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ZPX,
+		    &MOS6502::ins_ora<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ORA_ZPX,
 		  { "ora", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ZPX,
+		    &MOS6502::ins_ora<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::ASL_ZPX,
 		  { "asl", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.CLC_IMP,
+		    &MOS6502::ins_asl<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::CLC_IMP,
 		  { "clc", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_clc, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ABY,
+		    &MOS6502::ins_clc}},
+		{ OpcodeConstants::ORA_ABY,
 		  { "ora", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ABX,
+		    &MOS6502::ins_ora<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ORA_ABX,
 		  { "ora", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ABX,
+		    &MOS6502::ins_ora<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ASL_ABX,
 		  { "asl", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.JSR_ABS,
-		  { "jsr", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_jsr, this, std::placeholders::_1)}},
-		{ Opcodes.AND_IDX,
+		    &MOS6502::ins_asl<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::JSR_ABS,
+		  { "jsr", AddressingMode::Absolute, 3, 6, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_jsr}},
+		{ OpcodeConstants::AND_IDX,
 		  { "and", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.BIT_ZP,
+		    &MOS6502::ins_and<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::BIT_ZP,
 		  { "bit", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_bit, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ZP,
+		    &MOS6502::ins_bit<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::AND_ZP,
 		  { "and", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ZP,
+		    &MOS6502::ins_and<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::ROL_ZP,
 		  { "rol", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.PLP_IMP,
+		    &MOS6502::ins_rol<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::PLP_IMP,
 		  { "plp", AddressingMode::Implied, 1, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_plp, this, std::placeholders::_1)}},
-		{ Opcodes.AND_IMM,
+		    &MOS6502::ins_plp}},
+		{ OpcodeConstants::AND_IMM,
 		  { "and", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ACC,
+		    &MOS6502::ins_and<AddressingMode::Immediate>}},
+		{ OpcodeConstants::ROL_ACC,
 		  { "rol", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.BIT_ABS,
+		    &MOS6502::ins_rol<AddressingMode::Accumulator>}},
+		{ OpcodeConstants::BIT_ABS,
 		  { "bit", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_bit, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ABS,
+		    &MOS6502::ins_bit<AddressingMode::Absolute>}},
+		{ OpcodeConstants::AND_ABS,
 		  { "and", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ABS,
+		    &MOS6502::ins_and<AddressingMode::Absolute>}},
+		{ OpcodeConstants::ROL_ABS,
 		  { "rol", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.BMI_REL,
+		    &MOS6502::ins_rol<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BMI_REL,
 		  { "bmi", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bmi, this, std::placeholders::_1)}},
-		{ Opcodes.AND_IDY,
+		    &MOS6502::ins_bmi}},
+		{ OpcodeConstants::AND_IDY,
 		  { "and", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ZPX,
+		    &MOS6502::ins_and<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::AND_ZPX,
 		  { "and", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ZPX,
+		    &MOS6502::ins_and<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::ROL_ZPX,
 		  { "rol", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.SEC_IMP,
+		    &MOS6502::ins_rol<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::SEC_IMP,
 		  { "sec", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sec, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ABY,
+		    &MOS6502::ins_sec}},
+		{ OpcodeConstants::AND_ABY,
 		  { "and", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ABX,
+		    &MOS6502::ins_and<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::AND_ABX,
 		  { "and", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ABX,
+		    &MOS6502::ins_and<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ROL_ABX,
 		  { "rol", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.RTI_IMP,
-		  { "rti", AddressingMode::Implied, 1, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rti, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_IDX,
+		    &MOS6502::ins_rol<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::RTI_IMP,
+		  { "rti", AddressingMode::Implied, 1, 6, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_rti}},
+		{ OpcodeConstants::EOR_IDX,
 		  { "eor", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ZP,
+		    &MOS6502::ins_eor<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::EOR_ZP,
 		  { "eor", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ZP,
+		    &MOS6502::ins_eor<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::LSR_ZP,
 		  { "lsr", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.PHA_IMP,
+		    &MOS6502::ins_lsr<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::PHA_IMP,
 		  { "pha", AddressingMode::Implied, 1, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_pha, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_IMM,
+		    &MOS6502::ins_pha}},
+		{ OpcodeConstants::EOR_IMM,
 		  { "eor", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ACC,
+		    &MOS6502::ins_eor<AddressingMode::Immediate>}},
+		{ OpcodeConstants::LSR_ACC,
 		  { "lsr", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.JMP_ABS,
-		  { "jmp", AddressingMode::Absolute, 3, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_jmp, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ABS,
+		    &MOS6502::ins_lsr<AddressingMode::Accumulator>}},
+		{ OpcodeConstants::JMP_ABS,
+		  { "jmp", AddressingMode::Absolute, 3, 3, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_jmp<AddressingMode::Absolute>}},
+		{ OpcodeConstants::EOR_ABS,
 		  { "eor", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ABS,
+		    &MOS6502::ins_eor<AddressingMode::Absolute>}},
+		{ OpcodeConstants::LSR_ABS,
 		  { "lsr", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.BVC_REL,
+		    &MOS6502::ins_lsr<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BVC_REL,
 		  { "bvc", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bvc, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_IDY,
+		    &MOS6502::ins_bvc}},
+		{ OpcodeConstants::EOR_IDY,
 		  { "eor", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ZPX,
+		    &MOS6502::ins_eor<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::EOR_ZPX,
 		  { "eor", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ZPX,
+		    &MOS6502::ins_eor<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::LSR_ZPX,
 		  { "lsr", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.CLI_IMP,
+		    &MOS6502::ins_lsr<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::CLI_IMP,
 		  { "cli", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cli, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ABY,
+		    &MOS6502::ins_cli}},
+		{ OpcodeConstants::EOR_ABY,
 		  { "eor", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ABX,
+		    &MOS6502::ins_eor<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::EOR_ABX,
 		  { "eor", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ABX,
+		    &MOS6502::ins_eor<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::LSR_ABX,
 		  { "lsr", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.RTS_IMP,
-		  { "rts", AddressingMode::Implied, 1, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_rts, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IDX,
+		    &MOS6502::ins_lsr<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::RTS_IMP,
+		  { "rts", AddressingMode::Implied, 1, 6, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_rts}},
+		{ OpcodeConstants::ADC_IDX,
 		  { "adc", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ZP,
+		    &MOS6502::ins_adc<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::ADC_ZP,
 		  { "adc", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ZP,
+		    &MOS6502::ins_adc<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::ROR_ZP,
 		  { "ror", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.PLA_IMP,
+		    &MOS6502::ins_ror<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::PLA_IMP,
 		  { "pla", AddressingMode::Implied, 1, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_pla, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IMM,
+		    &MOS6502::ins_pla}},
+		{ OpcodeConstants::ADC_IMM,
 		  { "adc", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ACC,
+		    &MOS6502::ins_adc<AddressingMode::Immediate>}},
+		{ OpcodeConstants::ROR_ACC,
 		  { "ror", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.JMP_IND,
-		  { "jmp", AddressingMode::Indirect, 3, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_jmp, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABS,
+		    &MOS6502::ins_ror<AddressingMode::Accumulator>}},
+		{ OpcodeConstants::JMP_IND,
+		  { "jmp", AddressingMode::Indirect, 3, 5, InstructionFlags::EndsBlock,
+		    &MOS6502::ins_jmp<AddressingMode::Indirect>}},
+		{ OpcodeConstants::ADC_ABS,
 		  { "adc", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ABS,
+		    &MOS6502::ins_adc<AddressingMode::Absolute>}},
+		{ OpcodeConstants::ROR_ABS,
 		  { "ror", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.BVS_REL,
+		    &MOS6502::ins_ror<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BVS_REL,
 		  { "bvs", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bvs, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IDY,
+		    &MOS6502::ins_bvs}},
+		{ OpcodeConstants::ADC_IDY,
 		  { "adc", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ZPX,
+		    &MOS6502::ins_adc<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ADC_ZPX,
 		  { "adc", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ZPX,
+		    &MOS6502::ins_adc<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::ROR_ZPX,
 		  { "ror", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.SEI_IMP,
+		    &MOS6502::ins_ror<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::SEI_IMP,
 		  { "sei", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sei, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABY,
+		    &MOS6502::ins_sei}},
+		{ OpcodeConstants::ADC_ABY,
 		  { "adc", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABX,
+		    &MOS6502::ins_adc<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ADC_ABX,
 		  { "adc", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ABX,
+		    &MOS6502::ins_adc<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::ROR_ABX,
 		  { "ror", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.STA_IDX,
+		    &MOS6502::ins_ror<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::STA_IDX,
 		  { "sta", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STY_ZP,
+		    &MOS6502::ins_sta<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::STY_ZP,
 		  { "sty", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sty, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ZP,
+		    &MOS6502::ins_sty<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::STA_ZP,
 		  { "sta", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STX_ZP,
+		    &MOS6502::ins_sta<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::STX_ZP,
 		  { "stx", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_stx, this, std::placeholders::_1)}},
-		{ Opcodes.DEY_IMP,
+		    &MOS6502::ins_stx<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::DEY_IMP,
 		  { "dey", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dey, this, std::placeholders::_1)}},
-		{ Opcodes.TXA_IMP,
+		    &MOS6502::ins_dey}},
+		{ OpcodeConstants::TXA_IMP,
 		  { "txa", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_txa, this, std::placeholders::_1)}},
-		{ Opcodes.STY_ABS,
+		    &MOS6502::ins_txa}},
+		{ OpcodeConstants::STY_ABS,
 		  { "sty", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sty, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ABS,
+		    &MOS6502::ins_sty<AddressingMode::Absolute>}},
+		{ OpcodeConstants::STA_ABS,
 		  { "sta", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STX_ABS,
+		    &MOS6502::ins_sta<AddressingMode::Absolute>}},
+		{ OpcodeConstants::STX_ABS,
 		  { "stx", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_stx, this, std::placeholders::_1)}},
-		{ Opcodes.BCC_REL,
+		    &MOS6502::ins_stx<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BCC_REL,
 		  { "bcc", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bcc, this, std::placeholders::_1)}},
-		{ Opcodes.STA_IDY,
+		    &MOS6502::ins_bcc}},
+		{ OpcodeConstants::STA_IDY,
 		  { "sta", AddressingMode::IndirectY, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STY_ZPX,
+		    &MOS6502::ins_sta<AddressingMode::IndirectY>}},
+		{ OpcodeConstants::STY_ZPX,
 		  { "sty", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sty, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ZPX,
+		    &MOS6502::ins_sty<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::STA_ZPX,
 		  { "sta", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STX_ZPY,
+		    &MOS6502::ins_sta<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::STX_ZPY,
 		  { "stx", AddressingMode::ZeroPageY, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_stx, this, std::placeholders::_1)}},
-		{ Opcodes.TYA_IMP,
+		    &MOS6502::ins_stx<AddressingMode::ZeroPageY>}},
+		{ OpcodeConstants::TYA_IMP,
 		  { "tya", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_tya, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ABY,
+		    &MOS6502::ins_tya}},
+		{ OpcodeConstants::STA_ABY,
 		  { "sta", AddressingMode::AbsoluteY, 3, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.TXS_IMP,
+		    &MOS6502::ins_sta<AddressingMode::AbsoluteY>}},
+		{ OpcodeConstants::TXS_IMP,
 		  { "txs", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_txs, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ABX,
+		    &MOS6502::ins_txs}},
+		{ OpcodeConstants::STA_ABX,
 		  { "sta", AddressingMode::AbsoluteX, 3, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.LDY_IMM,
+		    &MOS6502::ins_sta<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::LDY_IMM,
 		  { "ldy", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldy, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_IDX,
+		    &MOS6502::ins_ldy<AddressingMode::Immediate>}},
+		{ OpcodeConstants::LDA_IDX,
 		  { "lda", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDX_IMM,
+		    &MOS6502::ins_lda<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::LDX_IMM,
 		  { "ldx", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldx, this, std::placeholders::_1)}},
-		{ Opcodes.LDY_ZP,
+		    &MOS6502::ins_ldx<AddressingMode::Immediate>}},
+		{ OpcodeConstants::LDY_ZP,
 		  { "ldy", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldy, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ZP,
+		    &MOS6502::ins_ldy<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::LDA_ZP,
 		  { "lda", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDX_ZP,
+		    &MOS6502::ins_lda<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::LDX_ZP,
 		  { "ldx", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldx, this, std::placeholders::_1)}},
-		{ Opcodes.TAY_IMP,
+		    &MOS6502::ins_ldx<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::TAY_IMP,
 		  { "tay", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_tay, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_IMM,
+		    &MOS6502::ins_tay}},
+		{ OpcodeConstants::LDA_IMM,
 		  { "lda", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.TAX_IMP,
+		    &MOS6502::ins_lda<AddressingMode::Immediate>}},
+		{ OpcodeConstants::TAX_IMP,
 		  { "tax", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_tax, this, std::placeholders::_1)}},
-		{ Opcodes.LDY_ABS,
+		    &MOS6502::ins_tax}},
+		{ OpcodeConstants::LDY_ABS,
 		  { "ldy", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldy, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ABS,
+		    &MOS6502::ins_ldy<AddressingMode::Absolute>}},
+		{ OpcodeConstants::LDA_ABS,
 		  { "lda", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDX_ABS,
+		    &MOS6502::ins_lda<AddressingMode::Absolute>}},
+		{ OpcodeConstants::LDX_ABS,
 		  { "ldx", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldx, this, std::placeholders::_1)}},
-		{ Opcodes.BCS_REL,
+		    &MOS6502::ins_ldx<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BCS_REL,
 		  { "bcs", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bcs, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_IDY,
+		    &MOS6502::ins_bcs}},
+		{ OpcodeConstants::LDA_IDY,
 		  { "lda", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDY_ZPX,
+		    &MOS6502::ins_lda<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::LDY_ZPX,
 		  { "ldy", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldy, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ZPX,
+		    &MOS6502::ins_ldy<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::LDA_ZPX,
 		  { "lda", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDX_ZPY,
+		    &MOS6502::ins_lda<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::LDX_ZPY,
 		  { "ldx", AddressingMode::ZeroPageY, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_ldx, this, std::placeholders::_1)}},
-		{ Opcodes.CLV_IMP,
+		    &MOS6502::ins_ldx<AddressingMode::ZeroPageY>}},
+		{ OpcodeConstants::CLV_IMP,
 		  { "clv", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_clv, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ABY,
+		    &MOS6502::ins_clv}},
+		{ OpcodeConstants::LDA_ABY,
 		  { "lda", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.TSX_IMP,
+		    &MOS6502::ins_lda<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::TSX_IMP,
 		  { "tsx", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_tsx, this, std::placeholders::_1)}},
-		{ Opcodes.LDY_ABX,
+		    &MOS6502::ins_tsx}},
+		{ OpcodeConstants::LDY_ABX,
 		  { "ldy", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_ldy, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ABX,
+		    &MOS6502::ins_ldy<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::LDA_ABX,
 		  { "lda", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.LDX_ABY,
+		    &MOS6502::ins_lda<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::LDX_ABY,
 		  { "ldx", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_ldx, this, std::placeholders::_1)}},
-		{ Opcodes.CPY_IMM,
+		    &MOS6502::ins_ldx<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::CPY_IMM,
 		  { "cpy", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpy, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_IDX,
+		    &MOS6502::ins_cpy<AddressingMode::Immediate>}},
+		{ OpcodeConstants::CMP_IDX,
 		  { "cmp", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.CPY_ZP,
+		    &MOS6502::ins_cmp<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::CPY_ZP,
 		  { "cpy", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpy, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ZP,
+		    &MOS6502::ins_cpy<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::CMP_ZP,
 		  { "cmp", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ZP,
+		    &MOS6502::ins_cmp<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::DEC_ZP,
 		  { "dec", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.INY_IMP,
+		    &MOS6502::ins_dec<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::INY_IMP,
 		  { "iny", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_iny, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_IMM,
+		    &MOS6502::ins_iny}},
+		{ OpcodeConstants::CMP_IMM,
 		  { "cmp", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.DEX_IMP,
+		    &MOS6502::ins_cmp<AddressingMode::Immediate>}},
+		{ OpcodeConstants::DEX_IMP,
 		  { "dex", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dex, this, std::placeholders::_1)}},
-		{ Opcodes.CPY_ABS,
+		    &MOS6502::ins_dex}},
+		{ OpcodeConstants::CPY_ABS,
 		  { "cpy", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpy, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ABS,
+		    &MOS6502::ins_cpy<AddressingMode::Absolute>}},
+		{ OpcodeConstants::CMP_ABS,
 		  { "cmp", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ABS,
+		    &MOS6502::ins_cmp<AddressingMode::Absolute>}},
+		{ OpcodeConstants::DEC_ABS,
 		  { "dec", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.BNE_REL,
+		    &MOS6502::ins_dec<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BNE_REL,
 		  { "bne", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_bne, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_IDY,
+		    &MOS6502::ins_bne}},
+		{ OpcodeConstants::CMP_IDY,
 		  { "cmp", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ZPX,
+		    &MOS6502::ins_cmp<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::CMP_ZPX,
 		  { "cmp", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ZPX,
+		    &MOS6502::ins_cmp<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::DEC_ZPX,
 		  { "dec", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.CLD_IMP,
+		    &MOS6502::ins_dec<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::CLD_IMP,
 		  { "cld", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cld, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ABY,
+		    &MOS6502::ins_cld}},
+		{ OpcodeConstants::CMP_ABY,
 		  { "cmp", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ABX,
+		    &MOS6502::ins_cmp<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::CMP_ABX,
 		  { "cmp", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ABX,
+		    &MOS6502::ins_cmp<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::DEC_ABX,
 		  { "dec", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.CPX_IMM,
+		    &MOS6502::ins_dec<AddressingMode::AbsoluteX>}},
+		{ OpcodeConstants::CPX_IMM,
 		  { "cpx", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpx, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IDX,
+		    &MOS6502::ins_cpx<AddressingMode::Immediate>}},
+		{ OpcodeConstants::SBC_IDX,
 		  { "sbc", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.CPX_ZP,
+		    &MOS6502::ins_sbc<AddressingMode::IndirectX>}},
+		{ OpcodeConstants::CPX_ZP,
 		  { "cpx", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpx, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ZP,
+		    &MOS6502::ins_cpx<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::SBC_ZP,
 		  { "sbc", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ZP,
+		    &MOS6502::ins_sbc<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::INC_ZP,
 		  { "inc", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_inc, this, std::placeholders::_1)}},
-		{ Opcodes.INX_IMP,
+		    &MOS6502::ins_inc<AddressingMode::ZeroPage>}},
+		{ OpcodeConstants::INX_IMP,
 		  { "inx", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_inx, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IMM,
+		    &MOS6502::ins_inx}},
+		{ OpcodeConstants::SBC_IMM,
 		  { "sbc", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.NOP_IMP,
+		    &MOS6502::ins_sbc<AddressingMode::Immediate>}},
+		{ OpcodeConstants::NOP_IMP,
 		  { "nop", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_nop, this, std::placeholders::_1)}},
-		{ Opcodes.CPX_ABS,
+		    &MOS6502::ins_nop}},
+		{ OpcodeConstants::CPX_ABS,
 		  { "cpx", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_cpx, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABS,
+		    &MOS6502::ins_cpx<AddressingMode::Absolute>}},
+		{ OpcodeConstants::SBC_ABS,
 		  { "sbc", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ABS,
+		    &MOS6502::ins_sbc<AddressingMode::Absolute>}},
+		{ OpcodeConstants::INC_ABS,
 		  { "inc", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_inc, this, std::placeholders::_1)}},
-		{ Opcodes.BEQ_REL,
+		    &MOS6502::ins_inc<AddressingMode::Absolute>}},
+		{ OpcodeConstants::BEQ_REL,
 		  { "beq", AddressingMode::Relative, 2, 2, InstructionFlags::Branch,
-		    std::bind(&MOS6502::ins_beq, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IDY,
+		    &MOS6502::ins_beq}},
+		{ OpcodeConstants::SBC_IDY,
 		  { "sbc", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ZPX,
+		    &MOS6502::ins_sbc<AddressingMode::IndirectY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::SBC_ZPX,
 		  { "sbc", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ZPX,
+		    &MOS6502::ins_sbc<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::INC_ZPX,
 		  { "inc", AddressingMode::ZeroPageX, 2, 6, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_inc, this, std::placeholders::_1)}},
-		{ Opcodes.SED_IMP,
+		    &MOS6502::ins_inc<AddressingMode::ZeroPageX>}},
+		{ OpcodeConstants::SED_IMP,
 		  { "sed", AddressingMode::Implied, 1, 2, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_sed, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABY,
+		    &MOS6502::ins_sed}},
+		{ OpcodeConstants::SBC_ABY,
 		  { "sbc", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABX,
+		    &MOS6502::ins_sbc<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::SBC_ABX,
 		  { "sbc", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
-		    std::bind(&MOS6502::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ABX,
+		    &MOS6502::ins_sbc<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>}},
+		{ OpcodeConstants::INC_ABX,
 		  { "inc", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::None,
-		    std::bind(&MOS6502::ins_inc, this, std::placeholders::_1)}},
+		    &MOS6502::ins_inc<AddressingMode::AbsoluteX>}},
+
+	});
 
-	};
+	return map;
 }
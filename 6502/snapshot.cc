@@ -0,0 +1,124 @@
+//
+// Machine snapshots
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <6502.h>
+
+// Bumped whenever the layout of a snapshot changes
+static constexpr uint16_t SNAPSHOT_VERSION = 3;
+
+// A snapshot is a header, the CPU's registers and pending interrupts, then memory (which
+// includes the state of mapped devices).  Debugger state isn't saved.
+std::vector<uint8_t> MOS6502::saveSnapshot() {
+	std::vector<uint8_t> buffer;
+	SnapshotWriter snapshot(buffer);
+
+	snapshot.putTag("M65S");
+	snapshot.put<uint16_t>(SNAPSHOT_VERSION);
+
+	snapshot.putTag("CPU ");
+	snapshot.put<uint16_t>(PC);
+	snapshot.put<uint8_t>(SP);
+	snapshot.put<uint8_t>(A);
+	snapshot.put<uint8_t>(X);
+	snapshot.put<uint8_t>(Y);
+	snapshot.put<uint8_t>(statusRegister());
+	snapshot.put<uint32_t>(_pendingEvents & (Event::Reset | Event::NMI | Event::IRQ));
+	snapshot.put<uint64_t>(_IRQCount);
+	snapshot.put<uint64_t>(_NMICount);
+	snapshot.put<uint64_t>(_BRKCount);
+	snapshot.put<uint16_t>(_haltAddress);
+	snapshot.put<uint8_t>(_haltAddressSet);
+	snapshot.put<uint8_t>(_infiniteLoopDetection);
+	snapshot.put<uint8_t>(_loopDetected);
+
+	mem.saveState(snapshot);
+	return buffer;
+}
+
+void MOS6502::restoreSnapshot(const std::span<const uint8_t> data) {
+	SnapshotReader snapshot(data);
+
+	snapshot.expectTag("M65S");
+	if (snapshot.get<uint16_t>() != SNAPSHOT_VERSION)
+		throw SnapshotReader::Exception("unsupported snapshot version");
+
+	// Read the CPU and memory aside and only load them once the whole snapshot has been read
+	snapshot.expectTag("CPU ");
+	const auto pc = snapshot.get<uint16_t>();
+	const auto sp = snapshot.get<uint8_t>();
+	const auto a  = snapshot.get<uint8_t>();
+	const auto x  = snapshot.get<uint8_t>();
+	const auto y  = snapshot.get<uint8_t>();
+	const auto ps = snapshot.get<uint8_t>();
+	const auto events = snapshot.get<uint32_t>() & (Event::Reset | Event::NMI | Event::IRQ);
+	const auto irqs = snapshot.get<uint64_t>();
+	const auto nmis = snapshot.get<uint64_t>();
+	const auto brks = snapshot.get<uint64_t>();
+	const auto haltAddress = snapshot.get<uint16_t>();
+	const bool haltAddressSet = snapshot.get<uint8_t>();
+	const bool loopDetection = snapshot.get<uint8_t>();
+	const bool loopDetected = snapshot.get<uint8_t>();
+
+	const auto restoreMemory = mem.readState(snapshot);
+	if (!snapshot.atEnd())
+		throw SnapshotReader::Exception("unexpected data after the last section");
+
+	restoreMemory();
+
+	PC = pc;
+	SP = sp;
+	A  = a;
+	X  = x;
+	Y  = y;
+	setStatusRegister(ps);
+	_pendingEvents = (_pendingEvents & ~(Event::Reset | Event::NMI | Event::IRQ)) | events;
+	_IRQCount = irqs;
+	_NMICount = nmis;
+	_BRKCount = brks;
+
+	unsetHaltAddress();
+	_haltAddress = haltAddress;
+	if (haltAddressSet)
+		setHaltAddress(haltAddress);
+	_infiniteLoopDetection = loopDetection;
+	_loopDetected = loopDetected;
+
+	_cycles = 0;
+	_expectedCyclesToUse = 0;
+}
+
+void MOS6502::saveSnapshot(const std::string& filename) {
+	const auto buffer = saveSnapshot();
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()))
+		throw std::runtime_error("Failed to write snapshot " + filename);
+}
+
+void MOS6502::restoreSnapshot(const std::string& filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+		throw std::runtime_error("Snapshot " + filename + " not found");
+
+	const std::vector<uint8_t> buffer{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	restoreSnapshot(buffer);
+}
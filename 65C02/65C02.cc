@@ -16,153 +16,14 @@
 // this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <65C02.h>
-
-MOS6502::AddressingMode MOS65C02::convertAddressingMode(const AddressingMode mode) {
-	return static_cast<MOS6502::AddressingMode>(mode);
-}
-
-bool MOS65C02::instructionIsAddressingMode(const Byte opcode, const AddressingMode addrmode) {
-	return static_cast<MOS65C02::AddressingMode>(_instructions.at(opcode).addrmode) == addrmode;
-}
-
-// 65C02 addressing modes.
-Word MOS65C02::getAddress(const Byte opcode) {
-	Word address;
-
-	auto checkPageBoundary = [&](Byte op, Word addr, Byte reg) {
-		if ((_instructions.at(op).flags & InstructionFlags::NoBoundaryCrossed) &&
-			((addr + reg) >> 8) == (addr >> 8)) {
-			_expectedCyclesToUse--;
-			_cycles--;
-		}
-	};
-
-	auto addressMode = static_cast<MOS65C02::AddressingMode>(_instructions.at(opcode).addrmode);
-
-	switch(addressMode) {
-	case AddressingMode::ZeroPageIndirect:
-		address = static_cast<Word>(readByteAtPC());
-		address = readWord(address);
-		break;
-	
-	case AddressingMode::AbsoluteIndexedIndirect:
-		address = readWordAtPC();
-		checkPageBoundary(opcode, address, X);
-		address += X;
-		_cycles++;
-		break;
-
-	default: // Must be a 6502 addressing mode
-		address = MOS6502::getAddress(opcode);
-		break;
-	}
-
-	return address;
-}
-
-// Argument decoding for Rockwell R65C02 specific instructions (BBRn abd BBSn).  These instruction mnemonics don't 
-// conform with the rest of the 65C02 & 6502 instructions.
-void MOS65C02::decodeRockwellArgs(Word& dPC, std::string& disassembly, std::string& opcodes, std::string& address) {
-
-	std::string zplabel, abslabel, zpaddr_str, reladdr_str, absaddr_str;
-	auto zpaddr  = readByte(dPC++);
-	auto reladdr = readByte(dPC++);
-	Word absaddr = PC + SByte(reladdr);
-
-	zpaddr_str= fmt::format("${:02x}", zpaddr);
-	zplabel = debugger.addressLabel(zpaddr);	
-
-	if (!zplabel.empty()) {
-		disassembly = zplabel;
-		address = zpaddr;
-	} else { 
-		disassembly = zpaddr_str;
-		address = "";
-	} 
-
-	reladdr_str = fmt::format("${:02x}", reladdr);
-	abslabel = debugger.addressLabel(absaddr);
-	absaddr_str = fmt::format("{:04x}", absaddr);
-
-	if (!abslabel.empty()) {
-		disassembly += "," + zplabel;
-		address += "," + abslabel;
-	} else { 
-		disassembly += "," + reladdr_str;
-		address = absaddr_str;
-	} 
-
-	opcodes += fmt::format("{:02x} {:02x} ", zpaddr, reladdr);
-	return;
-}
-
-
-// Argument decoding for 65C02/R65C02
-void MOS65C02::decodeArgs(Word& dPC, const bool atPC, const Byte ins, std::string& disassembly, std::string& opcodes, 
-						  std::string& address, std::string& computedAddr) {
-	Byte byteval;
-	Word wordval;
-	std::string out, addr, label;
-
-	// Check for Rockwell 65C02 BBRn or BBSn instructions. 
-	auto BBR_ins = (ins & 0x0f) == 0x0f;
-	auto BBS_ins = (ins & 0x07) == 0x07;
-	
-	if (BBR_ins || BBS_ins) {
-		decodeRockwellArgs(dPC, disassembly, opcodes, address);
-		return;
-	}
-
-	auto addressMode = static_cast<MOS65C02::AddressingMode>(_instructions.at(ins).addrmode);
-	switch (addressMode) {
-	case AddressingMode::ZeroPageIndirect:
-		byteval = readByte(dPC++);
-		wordval = readWord(byteval);
-		label = debugger.addressLabelSearch(wordval);
-		addr = fmt::format("(${:02})", byteval);
-
-		if (!label.empty()) {
-			disassembly = label;
-			address = addr;
-		} else {
-			disassembly = addr;
-			address = "";
-		}
-		opcodes += fmt::format("{:02x} ", byteval);
-		if (atPC) 
-			computedAddr = fmt::format("{:02x}", byteval);
-		break;
-
-	case AddressingMode::AbsoluteIndexedIndirect:
-		wordval = readWord(dPC++);
-		label = debugger.addressLabelSearch(wordval);
-		addr = fmt::format("(${:04x}", wordval);
-		if (!label.empty()) {
-			disassembly = label;
-			address = addr;
-		} else {
-			disassembly = addr;
-			address = "";
-		}
-		disassembly += ",X";
-		opcodes += fmt::format("{:02x} {:02x}", wordval & 0xff, (wordval >> 8) & 0xff);
-		if (atPC) 
-			computedAddr = fmt::format("${:04x}", wordval + X);
-
-		break;
-
-	default:
-		MOS6502::decodeArgs(dPC, atPC, ins, disassembly, opcodes, address, computedAddr);
-		break;
-	}
-}
+#include <instructions.h>
 
 //////////
 // 65C02 specific instructions
 
 // BRA
 void MOS65C02::ins_bra(const Byte opcode) {
-	Word address = getAddress(opcode);
+	Word address = getAddress<AddressingMode::Relative>(opcode);
 	
 	if ((PC >> 8) != (address >> 8)) { // Crossed page boundary
 		_cycles++;
@@ -174,14 +35,16 @@ void MOS65C02::ins_bra(const Byte opcode) {
 }
 
 // STZ
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_stz(const Byte opcode) {
-	Word address = getAddress(opcode);
+	Word address = getAddress<mode>(opcode);
 	writeByte(address, 0);
 }
 
 // TRB
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_trb(const Byte opcode) {
-	Word address = getAddress(opcode);
+	Word address = getAddress<mode>(opcode);
 	Byte data = readByte(address);
 	writeByte(address, data & ~A);
 	setFlagZByValue(data & A);
@@ -189,8 +52,9 @@ void MOS65C02::ins_trb(const Byte opcode) {
 }
 
 // TSB
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_tsb(const Byte opcode) {
-	Word address = getAddress(opcode);
+	Word address = getAddress<mode>(opcode);
 	Byte data = readByte(address);
 	writeByte(address, data | A);
 	setFlagZByValue(data & A);
@@ -226,8 +90,9 @@ void MOS65C02::ins_ply([[maybe_unused]] const Byte opcode) {
 }
 
 // SBC
+template<MOS6502::AddressingMode mode, uint8_t flags>
 void MOS65C02::ins_sbc(const Byte opcode) {
-	MOS6502::ins_sbc(opcode);
+	MOS6502::ins_sbc<mode, flags>(opcode);
 	if (Flags.D) {
 		_cycles++;
 		_expectedCyclesToUse++;
@@ -236,10 +101,14 @@ void MOS65C02::ins_sbc(const Byte opcode) {
 
 //////////
 // 6502 instructions with new addressing modes or behaviors on 65C02
+//
+// Instructions that only gain the new 65C02 addressing modes (AND, ASL, CMP, EOR, LDA, LSR, ORA,
+// ROL, ROR, STA) use the 6502 implementations directly.
 
 // ADC
+template<MOS6502::AddressingMode mode, uint8_t flags>
 void MOS65C02::ins_adc(const Byte opcode) {
-	MOS6502::ins_adc(opcode);
+	MOS6502::ins_adc<mode, flags>(opcode);
 	if (Flags.D) {
 		_cycles++;
 		_expectedCyclesToUse++;
@@ -247,24 +116,22 @@ void MOS65C02::ins_adc(const Byte opcode) {
 }
 
 // BIT
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_bit(const Byte opcode) {
-	bool V, N;
-	
-	if (instructionIsAddressingMode(opcode, AddressingMode::Immediate)) {
-		V = Flags.V;
-		N = Flags.N;
-	}
-
-	MOS6502::ins_bit(opcode);
-	
-	if (instructionIsAddressingMode(opcode, AddressingMode::Immediate)) {
+	if constexpr (mode == AddressingMode::Immediate) {
+		// BIT #imm only affects the Z flag
+		bool V = Flags.V;
+		Byte N = _nValue;
+		MOS6502::ins_bit<mode>(opcode);
 		Flags.V = V;
-		Flags.N = N;
+		setFlagNByValue(N);
+	} else {
+		MOS6502::ins_bit<mode>(opcode);
 	}
 
 	// Unlike all other Absolute,X instruction modes, this instruction doesn't consume one cycle more than Absolute.  
 	// Handle that quirk here.
-	if (instructionIsAddressingMode(opcode, AddressingMode::AbsoluteX))
+	if constexpr (mode == AddressingMode::AbsoluteX)
 		_cycles--;
 }
 
@@ -275,43 +142,41 @@ void MOS65C02::ins_brk(const Byte opcode) {
 }
 
 // DEC
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_dec(const Byte opcode) {
-	bool accumulator = instructionIsAddressingMode(opcode, AddressingMode::Accumulator);
-	if (accumulator) {
+	if constexpr (mode == AddressingMode::Accumulator) {
 		A--;
 		_cycles++;
 		setFlagZByValue(A);
 		setFlagNByValue(A);
 	} else {
-		MOS6502::ins_dec(opcode);
+		MOS6502::ins_dec<mode>(opcode);
 	}
 }
 
 // INC
+template<MOS6502::AddressingMode mode>
 void MOS65C02::ins_inc(const Byte opcode) {
-	bool accumulator = instructionIsAddressingMode(opcode, AddressingMode::Accumulator);
-	if (accumulator) {
+	if constexpr (mode == AddressingMode::Accumulator) {
 		A++;
 		_cycles++;
 		setFlagZByValue(A);
 		setFlagNByValue(A);
 	} else {
-		MOS6502::ins_inc(opcode);
+		MOS6502::ins_inc<mode>(opcode);
 	}
 }
 
 // JMP
 //   65C02 JMP fixes the 6502 JMP bug and introduces a new addressing mode
-void MOS65C02::ins_jmp(const Byte opcode) {
-	Word address = readWord(PC);
+template<MOS6502::AddressingMode mode>
+void MOS65C02::ins_jmp([[maybe_unused]] const Byte opcode) {
+	Word address = readWordAtPC();
 	
-	bool indirect = instructionIsAddressingMode(opcode, AddressingMode::Indirect);
-	bool absIndexedIndirect = instructionIsAddressingMode(opcode, AddressingMode::AbsoluteIndexedIndirect);
-
-	if (absIndexedIndirect) {
+	if constexpr (mode == AddressingMode::AbsoluteIndexedIndirect) {
 		address += X;
 	}
-	if (indirect || absIndexedIndirect) {
+	if constexpr (mode == AddressingMode::Indirect || mode == AddressingMode::AbsoluteIndexedIndirect) {
 		address = readWord(address);
 		_cycles++;
 	}
@@ -320,60 +185,189 @@ void MOS65C02::ins_jmp(const Byte opcode) {
 }
 
 //////////
-// 6502 instructions that support new 65C02 addressing modes
-
-// AND
-void MOS65C02::ins_and(const Byte opcode) {
-	MOS6502::ins_and(opcode);
-}
-
-// ASL
-void MOS65C02::ins_asl(const Byte opcode) {
-	MOS6502::ins_asl(opcode);
-}
-
-// CMP
-void MOS65C02::ins_cmp(const Byte opcode) {
-	MOS6502::ins_cmp(opcode);
-}
+// 65C02 instruction map
 
-// EOR
-void MOS65C02::ins_eor(const Byte opcode) {
-	MOS6502::ins_eor(opcode);
+const MOS6502::_instructionMap_t& MOS65C02::instructionMap() {
+	static const _instructionMap_t map = setup65C02Instructions();
+	return map;
 }
 
-// LDA
-void MOS65C02::ins_lda(const Byte opcode) {
-	MOS6502::ins_lda(opcode);
-}
-
-// LSR
-void MOS65C02::ins_lsr(const Byte opcode) {
-	MOS6502::ins_lsr(opcode);
-}
-
-// ORA
-void MOS65C02::ins_ora(const Byte opcode) {
-	MOS6502::ins_ora(opcode);
-}
-
-// ROR
-void MOS65C02::ins_ror(const Byte opcode) {
-	MOS6502::ins_ror(opcode);
-}
+MOS6502::_instructionMap_t MOS65C02::setup65C02Instructions() {
+	// Start from a fresh 6502 table, so a 65C02 never builds the 6502's own, and overlay the new and changed 65C02 instructions
+	auto map = MOS6502::setupInstructionMap();
 
-// STA
-void MOS65C02::ins_sta(const Byte opcode) {
-	MOS6502::ins_sta(opcode);
-}
+	addInstructions(map, {
+		// The table below is formatted as follows:
+		// { Opcode,
+		//   {"name", AddressingMode, ByteLength, CyclesUsed, Flags, Function pointer for instruction}}
+		{ OpcodeConstants::BRK_IMM,
+			{ "brk", AddressingMode::Immediate, 1, 7, InstructionFlags::EndsBlock,
+			handler(&MOS65C02::ins_brk)}},
+		{ OpcodeConstants::TSB_ZP,
+			{ "tsb", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_tsb<AddressingMode::ZeroPage>)}},
+		{ OpcodeConstants::TSB_ABS,
+			{ "tsb", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
+			handler(&MOS65C02::ins_tsb<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::ORA_ZPI,
+			{ "ora", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_ora<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::TRB_ZP,
+			{ "trb", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_trb<AddressingMode::ZeroPage>)}},
+		{ OpcodeConstants::INC_ACC,
+			{ "inc", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
+			handler(&MOS65C02::ins_inc<AddressingMode::Accumulator>)}},
+		{ OpcodeConstants::TRB_ABS,
+			{ "trb", AddressingMode::Absolute, 3, 6, InstructionFlags::None,
+			handler(&MOS65C02::ins_trb<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::ASL_ABX,
+			{ "asl", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_asl<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::AND_ZPI,
+			{ "and", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_and<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::BIT_ZPX,
+			{ "bit", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_bit<AddressingMode::ZeroPageX>)}},
+		{ OpcodeConstants::DEC_ACC,
+			{ "dec", AddressingMode::Accumulator, 1, 2, InstructionFlags::None,
+			handler(&MOS65C02::ins_dec<AddressingMode::Accumulator>)}},
+		{ OpcodeConstants::BIT_ABX,
+			{ "bit", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_bit<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::ROL_ABX,
+			{ "rol", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_rol<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::JMP_ABS,
+			{ "jmp", AddressingMode::Absolute, 3, 3, InstructionFlags::EndsBlock,
+			handler(&MOS65C02::ins_jmp<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::EOR_ZPI,
+			{ "eor", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_eor<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::PHY_IMP,
+			{ "phy", AddressingMode::Implied, 1, 3, InstructionFlags::None,
+			handler(&MOS65C02::ins_phy)}},
+		{ OpcodeConstants::LSR_ABX,
+			{ "lsr", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_lsr<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::ADC_IDX,
+			{ "adc", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::IndirectX>)}},
+		{ OpcodeConstants::STZ_ZP,
+			{ "stz", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
+			handler(&MOS65C02::ins_stz<AddressingMode::ZeroPage>)}},
+		{ OpcodeConstants::ADC_ZP,
+			{ "adc", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::ZeroPage>)}},
+		{ OpcodeConstants::ADC_IMM,
+			{ "adc", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::Immediate>)}},
+		{ OpcodeConstants::JMP_IND,
+			{ "jmp", AddressingMode::Indirect, 3, 6, InstructionFlags::EndsBlock,
+			handler(&MOS65C02::ins_jmp<AddressingMode::Indirect>)}},
+		{ OpcodeConstants::ADC_ABS,
+			{ "adc", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::ADC_IDY,
+			{ "adc", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_adc<AddressingMode::IndirectY, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::ADC_ZPI,
+			{ "adc", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::STZ_ZPX,
+			{ "stz", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_stz<AddressingMode::ZeroPageX>)}},
+		{ OpcodeConstants::ADC_ZPX,
+			{ "adc", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_adc<AddressingMode::ZeroPageX>)}},
+		{ OpcodeConstants::ADC_ABY,
+			{ "adc", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_adc<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::PLY_IMP,
+			{ "ply", AddressingMode::Implied, 1, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_ply)}},
+		{ OpcodeConstants::JMP_AII,
+			{ "jmp", AddressingMode::AbsoluteIndexedIndirect, 3, 6, InstructionFlags::EndsBlock,
+			handler(&MOS65C02::ins_jmp<AddressingMode::AbsoluteIndexedIndirect>)}},
+		{ OpcodeConstants::ADC_ABX,
+			{ "adc", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_adc<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::ROR_ABX,
+			{ "ror", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_ror<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::BRA_REL,
+			{ "bra", AddressingMode::Relative, 2, 3, InstructionFlags::PageBoundary | InstructionFlags::EndsBlock,
+			handler(&MOS65C02::ins_bra)}},
+		{ OpcodeConstants::BIT_IMM,
+			{ "bit", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
+			handler(&MOS65C02::ins_bit<AddressingMode::Immediate>)}},
+		{ OpcodeConstants::STA_ZPI,
+			{ "sta", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_sta<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::STZ_ABS,
+			{ "stz", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_stz<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::STZ_ABX,
+			{ "stz", AddressingMode::AbsoluteX, 3, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_stz<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::LDA_ZPI,
+			{ "lda", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_lda<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::CMP_ZPI,
+			{ "cmp", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_cmp<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::PHX_IMP,
+			{ "phx", AddressingMode::Implied, 1, 3, InstructionFlags::None,
+			handler(&MOS65C02::ins_phx)}},
+		{ OpcodeConstants::DEC_ABX,
+			{ "dec", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_dec<AddressingMode::AbsoluteX>)}},
+		{ OpcodeConstants::SBC_IDX,
+			{ "sbc", AddressingMode::IndirectX, 2, 6, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::IndirectX>)}},
+		{ OpcodeConstants::SBC_ZP,
+			{ "sbc", AddressingMode::ZeroPage, 2, 3, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::ZeroPage>)}},
+		{ OpcodeConstants::SBC_IMM,
+			{ "sbc", AddressingMode::Immediate, 2, 2, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::Immediate>)}},
+		{ OpcodeConstants::SBC_ABS,
+			{ "sbc", AddressingMode::Absolute, 3, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::Absolute>)}},
+		{ OpcodeConstants::SBC_IDY,
+			{ "sbc", AddressingMode::IndirectY, 2, 5, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_sbc<AddressingMode::IndirectY, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::SBC_ZPI,
+			{ "sbc", AddressingMode::ZeroPageIndirect, 2, 5, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::ZeroPageIndirect>)}},
+		{ OpcodeConstants::SBC_ZPX,
+			{ "sbc", AddressingMode::ZeroPageX, 2, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_sbc<AddressingMode::ZeroPageX>)}},
+		{ OpcodeConstants::SBC_ABY,
+			{ "sbc", AddressingMode::AbsoluteY, 3, 4, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_sbc<AddressingMode::AbsoluteY, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::PLX_IMP,
+			{ "plx", AddressingMode::Implied, 1, 4, InstructionFlags::None,
+			handler(&MOS65C02::ins_plx)}},
+		{ OpcodeConstants::SBC_ABX,
+			{ "sbc", AddressingMode::AbsoluteX, 3, 4, InstructionFlags::PageBoundary,
+			handler(&MOS65C02::ins_sbc<AddressingMode::AbsoluteX, InstructionFlags::PageBoundary>)}},
+		{ OpcodeConstants::INC_ABX,
+			{ "inc", AddressingMode::AbsoluteX, 3, 7, InstructionFlags::NoBoundaryCrossed,
+			handler(&MOS65C02::ins_inc<AddressingMode::AbsoluteX>)}},
+	});
+
+	return map;
+}	
 
-// Instructions only available on the Rockwell variants of the 65C02 (R65C02).
-// These are assumed by the extended opcode tests.
+//////////
+// R65C02 specific instructions
 
 // BBR - Branch on Bit Reset
-void MOS65C02::ins_bbr(const Byte opcode) {
+void R65C02::ins_bbr(const Byte opcode) {
 	Byte zpaddr = readByteAtPC();
-	Word address = getAddress(opcode);
+	Word address = getAddress<AddressingMode::Relative>(opcode);
 	Byte m = readByte(zpaddr);
 
 	Byte bitmask = 1 << (opcode >> 4);
@@ -383,9 +377,9 @@ void MOS65C02::ins_bbr(const Byte opcode) {
 }
 
 // BBS - Branch on Bit Set
-void MOS65C02::ins_bbs(const Byte opcode) {
+void R65C02::ins_bbs(const Byte opcode) {
 	Byte zpaddr = readByteAtPC();
-	Word address = getAddress(opcode);
+	Word address = getAddress<AddressingMode::Relative>(opcode);
 	Byte m = readByte(zpaddr);
 
 	Byte bitmask = 1 << ((opcode >> 4) - 8);
@@ -395,7 +389,7 @@ void MOS65C02::ins_bbs(const Byte opcode) {
 }
 
 // RMB - Reset Memory Bit
-void MOS65C02::ins_rmb(const Byte opcode) {
+void R65C02::ins_rmb(const Byte opcode) {
 	Byte zpaddr = readByteAtPC();
 	Byte bitmask = 1 << ((opcode >> 4));
 	Byte m = readByte(zpaddr);
@@ -405,7 +399,7 @@ void MOS65C02::ins_rmb(const Byte opcode) {
 }
 
 // SMB - Set Memory Bit
-void MOS65C02::ins_smb(const Byte opcode) {
+void R65C02::ins_smb(const Byte opcode) {
 	Byte zpaddr = readByteAtPC();
 	Byte bitmask = 1 << ((opcode >> 4) - 8);
 	Byte m = readByte(zpaddr);
@@ -415,276 +409,118 @@ void MOS65C02::ins_smb(const Byte opcode) {
 }
 
 //////////
-// 65C02/R65C02 instruction map
-
-MOS6502::_instructionMap_t MOS65C02::setup65C02Instructions() {
-	const _instructionMap_t newInstructions = {
-		// The table below is formatted as follows:
-		// { Opcode,
-		//   {"name", AddressingMode, ByteLength, CyclesUsed, Flags, Function pointer for instruction}}
-		{ Opcodes.BRK_IMM,
-			{ "brk", convertAddressingMode(AddressingMode::Immediate), 1, 7, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_brk, this, std::placeholders::_1)}},
-		{ Opcodes.TSB_ZP,
-			{ "tsb", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_tsb, this, std::placeholders::_1)}},
-		{ Opcodes.TSB_ABS,
-			{ "tsb", convertAddressingMode(AddressingMode::Absolute), 3, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_tsb, this, std::placeholders::_1)}},
-		{ Opcodes.ORA_ZPI,
-			{ "ora", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_ora, this, std::placeholders::_1)}},
-		{ Opcodes.TRB_ZP,
-			{ "trb", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_trb, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ACC,
-			{ "inc", convertAddressingMode(AddressingMode::Accumulator), 1, 2, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_inc, this, std::placeholders::_1)}},
-		{ Opcodes.TRB_ABS,
-			{ "trb", convertAddressingMode(AddressingMode::Absolute), 3, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_trb, this, std::placeholders::_1)}},
-		{ Opcodes.ASL_ABX,
-			{ "asl", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_asl, this, std::placeholders::_1)}},
-		{ Opcodes.AND_ZPI,
-			{ "and", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_and, this, std::placeholders::_1)}},
-		{ Opcodes.BIT_ZPX,
-			{ "bit", convertAddressingMode(AddressingMode::ZeroPageX), 2, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bit, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ACC,
-			{ "dec", convertAddressingMode(AddressingMode::Accumulator), 1, 2, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.BIT_ABX,
-			{ "bit", convertAddressingMode(AddressingMode::AbsoluteX), 3, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bit, this, std::placeholders::_1)}},
-		{ Opcodes.ROL_ABX,
-			{ "rol", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_rol, this, std::placeholders::_1)}},
-		{ Opcodes.JMP_ABS,
-			{ "jmp", convertAddressingMode(AddressingMode::Absolute), 3, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_jmp, this, std::placeholders::_1)}},
-		{ Opcodes.EOR_ZPI,
-			{ "eor", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_eor, this, std::placeholders::_1)}},
-		{ Opcodes.PHY_IMP,
-			{ "phy", convertAddressingMode(AddressingMode::Implied), 1, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_phy, this, std::placeholders::_1)}},
-		{ Opcodes.LSR_ABX,
-			{ "lsr", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_lsr, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IDX,
-			{ "adc", convertAddressingMode(AddressingMode::IndirectX), 2, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.STZ_ZP,
-			{ "stz", convertAddressingMode(AddressingMode::ZeroPage), 2, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_stz, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ZP,
-			{ "adc", convertAddressingMode(AddressingMode::ZeroPage), 2, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IMM,
-			{ "adc", convertAddressingMode(AddressingMode::Immediate), 2, 2, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.JMP_IND,
-			{ "jmp", convertAddressingMode(AddressingMode::Indirect), 3, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_jmp, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABS,
-			{ "adc", convertAddressingMode(AddressingMode::Absolute), 3, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_IDY,
-			{ "adc", convertAddressingMode(AddressingMode::IndirectY), 2, 5, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ZPI,
-			{ "adc", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.STZ_ZPX,
-			{ "stz", convertAddressingMode(AddressingMode::ZeroPageX), 2, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_stz, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ZPX,
-			{ "adc", convertAddressingMode(AddressingMode::ZeroPageX), 2, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABY,
-			{ "adc", convertAddressingMode(AddressingMode::AbsoluteY), 3, 4, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.PLY_IMP,
-			{ "ply", convertAddressingMode(AddressingMode::Implied), 1, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_ply, this, std::placeholders::_1)}},
-		{ Opcodes.JMP_AII,
-			{ "jmp", convertAddressingMode(AddressingMode::AbsoluteIndexedIndirect), 3, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_jmp, this, std::placeholders::_1)}},
-		{ Opcodes.ADC_ABX,
-			{ "adc", convertAddressingMode(AddressingMode::AbsoluteX), 3, 4, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_adc, this, std::placeholders::_1)}},
-		{ Opcodes.ROR_ABX,
-			{ "ror", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_ror, this, std::placeholders::_1)}},
-		{ Opcodes.BRA_REL,
-			{ "bra", convertAddressingMode(AddressingMode::Relative), 2, 3, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_bra, this, std::placeholders::_1)}},
-		{ Opcodes.BIT_IMM,
-			{ "bit", convertAddressingMode(AddressingMode::Immediate), 2, 2, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bit, this, std::placeholders::_1)}},
-		{ Opcodes.STA_ZPI,
-			{ "sta", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sta, this, std::placeholders::_1)}},
-		{ Opcodes.STZ_ABS,
-			{ "stz", convertAddressingMode(AddressingMode::Absolute), 3, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_stz, this, std::placeholders::_1)}},
-		{ Opcodes.STZ_ABX,
-			{ "stz", convertAddressingMode(AddressingMode::AbsoluteX), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_stz, this, std::placeholders::_1)}},
-		{ Opcodes.LDA_ZPI,
-			{ "lda", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_lda, this, std::placeholders::_1)}},
-		{ Opcodes.CMP_ZPI,
-			{ "cmp", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_cmp, this, std::placeholders::_1)}},
-		{ Opcodes.PHX_IMP,
-			{ "phx", convertAddressingMode(AddressingMode::Implied), 1, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_phx, this, std::placeholders::_1)}},
-		{ Opcodes.DEC_ABX,
-			{ "dec", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_dec, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IDX,
-			{ "sbc", convertAddressingMode(AddressingMode::IndirectX), 2, 6, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ZP,
-			{ "sbc", convertAddressingMode(AddressingMode::ZeroPage), 2, 3, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IMM,
-			{ "sbc", convertAddressingMode(AddressingMode::Immediate), 2, 2, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABS,
-			{ "sbc", convertAddressingMode(AddressingMode::Absolute), 3, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_IDY,
-			{ "sbc", convertAddressingMode(AddressingMode::IndirectY), 2, 5, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ZPI,
-			{ "sbc", convertAddressingMode(AddressingMode::ZeroPageIndirect), 2, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ZPX,
-			{ "sbc", convertAddressingMode(AddressingMode::ZeroPageX), 2, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABY,
-			{ "sbc", convertAddressingMode(AddressingMode::AbsoluteY), 3, 4, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.PLX_IMP,
-			{ "plx", convertAddressingMode(AddressingMode::Implied), 1, 4, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_plx, this, std::placeholders::_1)}},
-		{ Opcodes.SBC_ABX,
-			{ "sbc", convertAddressingMode(AddressingMode::AbsoluteX), 3, 4, InstructionFlags::PageBoundary,
-			std::bind(&MOS65C02::ins_sbc, this, std::placeholders::_1)}},
-		{ Opcodes.INC_ABX,
-			{ "inc", convertAddressingMode(AddressingMode::AbsoluteX), 3, 7, InstructionFlags::NoBoundaryCrossed,
-			std::bind(&MOS65C02::ins_inc, this, std::placeholders::_1)}},
-
-		// R65C02 instructions
-		{ Opcodes.BBR0,
-			{ "bbr0", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR1,
-			{ "bbr1", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR2,
-			{ "bbr2", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR3,
-			{ "bbr3", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR4,
-			{ "bbr4", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR5,
-			{ "bbr5", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR6,
-			{ "bbr6", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-		{ Opcodes.BBR7,
-			{ "bbr7", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbr, this, std::placeholders::_1)}},
-
-		{ Opcodes.BBS0,
-			{ "bbs0", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS1,
-			{ "bbs1", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS2,
-			{ "bbs2", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS3,
-			{ "bbs3", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS4,
-			{ "bbs4", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS5,
-			{ "bbs5", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS6,
-			{ "bbs6", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-		{ Opcodes.BBS7,
-			{ "bbs7", convertAddressingMode(AddressingMode::Relative), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_bbs, this, std::placeholders::_1)}},
-
-		{ Opcodes.RMB0,
-			{ "rmb0", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB1,
-			{ "rmb1", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB2,
-			{ "rmb2", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB3,
-			{ "rmb3", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB4,
-			{ "rmb4", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB5,
-			{ "rmb5", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB6,
-			{ "rmb6", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-		{ Opcodes.RMB7,
-			{ "rmb7", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_rmb, this, std::placeholders::_1)}},
-
-		{ Opcodes.SMB0,
-			{ "smb0", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB1,
-			{ "smb1", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB2,
-			{ "smb2", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB3,
-			{ "smb3", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB4,
-			{ "smb4", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB5,
-			{ "smb5", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB6,
-			{ "smb6", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-		{ Opcodes.SMB7,
-			{ "smb7", convertAddressingMode(AddressingMode::ZeroPage), 3, 5, InstructionFlags::None,
-			std::bind(&MOS65C02::ins_smb, this, std::placeholders::_1)}},
-	};
-
-	// Fold the new instructions into the 6502 instruction map
-	auto instructions = MOS6502::setupInstructionMap();
-	for (const auto& pair : newInstructions) {
-		instructions[pair.first] = pair.second;
-	}
-	return instructions;
-}	
+// R65C02 instruction map
+
+const MOS6502::_instructionMap_t& R65C02::instructionMap() {
+	static const _instructionMap_t map = setupR65C02Instructions();
+	return map;
+}
+
+MOS6502::_instructionMap_t R65C02::setupR65C02Instructions() {
+	// Start from a fresh 65C02 table and add the bit instructions
+	auto map = MOS65C02::setup65C02Instructions();
+
+	addInstructions(map, {
+		{ OpcodeConstants::BBR0,
+			{ "bbr0", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR1,
+			{ "bbr1", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR2,
+			{ "bbr2", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR3,
+			{ "bbr3", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR4,
+			{ "bbr4", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR5,
+			{ "bbr5", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR6,
+			{ "bbr6", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+		{ OpcodeConstants::BBR7,
+			{ "bbr7", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbr)}},
+
+		{ OpcodeConstants::BBS0,
+			{ "bbs0", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS1,
+			{ "bbs1", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS2,
+			{ "bbs2", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS3,
+			{ "bbs3", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS4,
+			{ "bbs4", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS5,
+			{ "bbs5", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS6,
+			{ "bbs6", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+		{ OpcodeConstants::BBS7,
+			{ "bbs7", AddressingMode::Relative, 3, 5, InstructionFlags::None,
+			handler(&R65C02::ins_bbs)}},
+
+		{ OpcodeConstants::RMB0,
+			{ "rmb0", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB1,
+			{ "rmb1", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB2,
+			{ "rmb2", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB3,
+			{ "rmb3", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB4,
+			{ "rmb4", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB5,
+			{ "rmb5", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB6,
+			{ "rmb6", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+		{ OpcodeConstants::RMB7,
+			{ "rmb7", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_rmb)}},
+
+		{ OpcodeConstants::SMB0,
+			{ "smb0", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB1,
+			{ "smb1", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB2,
+			{ "smb2", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB3,
+			{ "smb3", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB4,
+			{ "smb4", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB5,
+			{ "smb5", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB6,
+			{ "smb6", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+		{ OpcodeConstants::SMB7,
+			{ "smb7", AddressingMode::ZeroPage, 2, 5, InstructionFlags::None,
+			handler(&R65C02::ins_smb)}},
+	});
+
+	return map;
+}
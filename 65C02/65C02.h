@@ -19,9 +19,7 @@
 
 class MOS65C02 : public MOS6502 {
 public:
-    MOS65C02(Memory<Word, Byte>& m) : MOS6502(m)  {
-		_instructions = setup65C02Instructions();
-	}
+    MOS65C02(Memory<Word, Byte>& m) : MOS65C02(m, instructionMap().data()) {}
 
 	// Must be public so the tests can access
     class OpcodeConstants : public MOS6502::OpcodeConstants {
@@ -101,8 +99,56 @@ public:
 
         static constexpr Byte TSB_ABS = 0x0c;
        	static constexpr Byte TSB_ZP  = 0x04;
+    };
+	OpcodeConstants Opcodes;
+
+protected:
+	// For variants, which pass in their own instruction table
+	MOS65C02(Memory<Word, Byte>& m, const instruction* instructions) : MOS6502(m, instructions) {}
+
+    class InstructionFlags : public MOS6502::InstructionFlags {
+	public:
+        static constexpr uint8_t NoBoundaryCrossed = 4;
+	};
+
+	static _instructionMap_t setup65C02Instructions(); 
+
+private:
+
+	// 65C02 specific instructions
+	void ins_bra(Byte);
+	template<AddressingMode> void ins_stz(Byte);
+	template<AddressingMode> void ins_trb(Byte);
+	template<AddressingMode> void ins_tsb(Byte);
+	void ins_phx(Byte);
+	void ins_phy(Byte);
+	void ins_plx(Byte);
+	void ins_ply(Byte);
+	
+	// 6502 instructions with new behaviors on 65C02
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_adc(Byte);
+	template<AddressingMode> void ins_bit(Byte);
+	void ins_brk(Byte);
+	template<AddressingMode> void ins_dec(Byte);
+	template<AddressingMode> void ins_inc(Byte);
+	template<AddressingMode> void ins_jmp(Byte);
+	template<AddressingMode, uint8_t = InstructionFlags::None> void ins_sbc(Byte);
+
+	// 65C02 handlers are stored in the MOS6502 instruction table and are only ever invoked on a MOS65C02.
+	static opfn_t handler(void (MOS65C02::*fn)(Byte)) { return static_cast<opfn_t>(fn); }
+
+	static const _instructionMap_t& instructionMap();
+}; // class 65C02
+
+// The Rockwell R65C02: a 65C02 with instructions that test, reset and set single bits in zero
+// page.  These are assumed by the extended opcode tests.
+class R65C02 : public MOS65C02 {
+public:
+	R65C02(Memory<Word, Byte>& m) : MOS65C02(m, instructionMap().data()) {}
 
-		// R65C02 opcodes
+	// Must be public so the tests can access
+	class OpcodeConstants : public MOS65C02::OpcodeConstants {
+	public:
 		static constexpr Byte BBR0    = 0x0f;
 		static constexpr Byte BBR1    = 0x1f;
 		static constexpr Byte BBR2    = 0x2f;
@@ -138,77 +184,17 @@ public:
 		static constexpr Byte SMB5    = 0xd7;
 		static constexpr Byte SMB6    = 0xe7;
 		static constexpr Byte SMB7    = 0xf7;
-    };
+	};
 	OpcodeConstants Opcodes;
 
 private:
-
-    class InstructionFlags : public MOS6502::InstructionFlags {
-	public:
-        static constexpr uint8_t NoBoundaryCrossed = 4;
-	};
-
-	enum AddressingMode {
-		// 6502 modes
-		Immediate,
-		ZeroPage,
-		ZeroPageX,
-		ZeroPageY,
-		Relative,
-		Absolute,
-		AbsoluteX,
-		AbsoluteY,
-		Indirect,
-		IndirectX,
-		IndirectY,
-		Implied,
-		Accumulator,
-		// 65C02 modes
-		ZeroPageIndirect,
-		AbsoluteIndexedIndirect
-	};
-	
-	MOS6502::AddressingMode convertAddressingMode(AddressingMode);
-	bool instructionIsAddressingMode(Byte, AddressingMode);
-	Word getAddress(Byte);
-	void decodeArgs(Word&, const bool, const Byte, std::string&, std::string&, std::string&, std::string&);
-	void decodeRockwellArgs(Word&, std::string&, std::string&, std::string&);
-
-
-	// 65C02 specific instructions
-	void ins_bra(Byte);
-	void ins_stz(Byte);
-	void ins_trb(Byte);
-	void ins_tsb(Byte);
-	void ins_phx(Byte);
-	void ins_phy(Byte);
-	void ins_plx(Byte);
-	void ins_ply(Byte);
-	
-	// 6502 instructions with new modes/flags on 65C02
-	void ins_adc(Byte);
-	void ins_and(Byte);
-	void ins_asl(Byte);
-	void ins_bit(Byte);
-	void ins_brk(Byte);
-	void ins_cmp(Byte);
-	void ins_dec(Byte);
-	void ins_eor(Byte);
-	void ins_inc(Byte);
-	void ins_jmp(Byte);
-	void ins_lda(Byte);
-	void ins_lsr(Byte);
-	void ins_ora(Byte);
-	void ins_ror(Byte);
-	void ins_sbc(Byte);
-	void ins_sta(Byte);
-	
-	// Instructions only available on the Rockwell variants of the 65C02 (R65C02).
-	// These are assumed by the extended tests.
 	void ins_bbr(Byte);
 	void ins_bbs(Byte);
 	void ins_rmb(Byte);
 	void ins_smb(Byte);
 
-	MOS6502::_instructionMap_t setup65C02Instructions(); 
-}; // class 65C02
+	static opfn_t handler(void (R65C02::*fn)(Byte)) { return static_cast<opfn_t>(fn); }
+
+	static const _instructionMap_t& instructionMap();
+	static _instructionMap_t setupR65C02Instructions();
+}; // class R65C02
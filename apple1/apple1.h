@@ -0,0 +1,294 @@
+//
+// The Apple 1 machine, shared by the 6502 and 65C02 front ends
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fmt/core.h>
+
+#include <memory.h>
+
+#include "mos6820.h"
+#include "idle.h"
+#include "clock.h"
+#include "bus.h"
+#include "script.h"
+#include "paste.h"
+
+//
+// An Apple1 is the whole machine: memory with WozMon, Integer BASIC and a
+// sample program loaded, the PIA, the bus and its clock, and the command
+// line options for running headless and pasting.  A front end only picks
+// the CPU and the sample program, and calls main().
+//
+template<class CPU>
+class Apple1 {
+public:
+	using Address = uint16_t;
+	using Cell    = uint8_t;
+
+	Apple1(const char* cpuName, const std::vector<Cell>& sampleProgram) :
+		_cpuName(cpuName), _sampleProgram(sampleProgram) { }
+
+	// Returns the emulator's exit status
+	int main(int argc, char* argv[]) {
+		if (!parseCommandLine(argc, argv))
+			return 1;
+		const bool headless = !_scriptFile.empty();
+
+		if (!headless) {
+			fmt::print("A Very Simple Apple I ({})\n", _cpuName);
+			fmt::print("  Reset        = Control-\\\n");
+			fmt::print("  Clear screen = Control-[\n");
+			fmt::print("  Debugger     = Control-]\n");
+			fmt::print("  Quit         = Control-Backspace\n");
+			fmt::print("\n");
+		}
+
+		setupMemoryMap();
+
+		// Headless, the bus clock runs as fast as it can
+		std::shared_ptr<KeyScript<Address, Cell>> script;
+		if (headless) {
+			if (!(script = setupHeadless()))
+				return 1;
+			_busClock.disableTimingEmulation();
+		} else {
+			_busClock.enableTimingEmulation();
+		}
+		if (_haveHaltAddress)
+			_cpu.setHaltAddress(_haltAddress);
+		if (!_pasteFile.empty() && !setupPaste())
+			return 1;
+		_bus.setup();
+
+		// Order of operations:
+		// - Run the CPU until the next device event is due, or one debugger command in debug mode, then
+		// - Run the device events that are due and handle any control signals they asserted, then
+		// - Delay however many clock cycles we've used, or if the CPU is only waiting for a key, block
+		//   until one arrives.  Headless, the script supplies the keys, so neither happens, and while
+		//   something's being pasted the CPU runs flat out.
+
+		bool pasting = false;
+		_cpu.Reset();	    // Exit the CPU from reset
+		while (!_cpu.isPCAtHaltAddress() && !_bus.exiting()) {
+			if (_cpu.isInDebugMode())
+				_idle->cancel();
+
+			const auto cycles = _bus.step();
+			if (headless)
+				continue;
+
+			// Time spent waiting for a key passes for the devices too
+			if (!_cpu.isInDebugMode() && _idle->check(_pia->pollingIdle(), _cpu.getPC())) {
+				_bus.advance(_busClock.advance(_pia->waitForInput(IDLE_WAIT)));
+			} else if (_pia->pasting()) {
+				pasting = true;
+			} else {
+				if (std::exchange(pasting, false))
+					_busClock.enableTimingEmulation();	// Pace from now, rather than catch up the paste
+				_busClock.delay(cycles);
+			}
+		}
+
+		_bus.teardown();
+		if (headless)
+			return _cpu.isPCAtHaltAddress() ? 0 : script->status();
+
+		if (_bus.exiting())
+			fmt::print("\nExiting emulator\n");
+
+		return 0;
+	}
+
+private:
+	// WozMon (in ROM)
+	static constexpr Address WOZMON_ADDRESS = 0xff00;
+	static constexpr const char* WOZMON_FILE = BINFILE_PATH "/wozmon.bin";
+
+	// Apple Integer Basic (normally loaded from cassette)
+	static constexpr Address BASIC_ADDRESS = 0xe000;
+	static constexpr const char* BASIC_FILE = BINFILE_PATH "/Apple-1_Integer_BASIC.bin";
+
+	// The sample program from the Apple 1 Manual (normally entered by hand via WozMon)
+	static constexpr Address SAMPLE_ADDRESS = 0x0000;
+
+	static constexpr int CLOCK_MHZ = 1;
+	static constexpr uint64_t MAXIMUM_SLICE = 1000 * CLOCK_MHZ;	// Run at most ~1ms of CPU time between device events
+	static constexpr auto IDLE_WAIT = std::chrono::milliseconds(100);	// Longest to block waiting for a key when idle
+	static constexpr Address PIA_ADDRESS = 0xd010;
+
+	const char* _cpuName;
+	std::vector<Cell> _sampleProgram;
+
+	Memory<Address, Cell> _mem{CPU::LAST_ADDRESS};
+	CPU _cpu{_mem};
+	std::shared_ptr<MOS6820<Address, Cell>> _pia = std::make_shared<MOS6820<Address, Cell>>();
+	std::shared_ptr<IdleDetector<Address, Cell>> _idle = std::make_shared<IdleDetector<Address, Cell>>(_mem);
+	Bus<CPU, Address, Cell> _bus{_cpu, _mem, MAXIMUM_SLICE};
+	BusClock_t _busClock{CLOCK_MHZ};
+
+	// Headless mode: keys come from a script rather than the terminal, and the display goes to a file
+	std::string _scriptFile;
+	std::string _outputFile;
+	uint64_t _timeoutMs = 0;
+	Address _haltAddress = 0;
+	bool _haveHaltAddress = false;
+
+	// Text to paste once the machine starts, optionally with WozMon deposits stored straight into memory
+	std::string _pasteFile;
+	bool _storeHex = false;
+
+	static void help() {
+		fmt::print("Usage: program [options]\n"
+				   "Options:\n"
+				   "  --help             Show this help message\n"
+				   "  --script=<file>    Run without a terminal, typing the keys in file ('-' for standard input)\n"
+				   "  --output=<file>    With --script, write the display to file rather than standard output\n"
+				   "  --timeout=<ms>     With --script, give up after ms milliseconds of emulated time\n"
+				   "  --halt=<address>   Exit when the CPU reaches address\n"
+				   "  --paste=<file>     Type the contents of file as fast as the Apple 1 takes them\n"
+				   "  --store-hex        With --paste, store WozMon 'XXXX: bytes' lines straight into memory\n");
+	}
+
+	bool parseCommandLine(int argc, char* argv[]) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--help") {
+				help();
+				return false;
+			} else if (arg.rfind("--script=", 0) == 0) {
+				_scriptFile = arg.substr(9);
+			} else if (arg.rfind("--output=", 0) == 0) {
+				_outputFile = arg.substr(9);
+			} else if (arg.rfind("--timeout=", 0) == 0) {
+				std::istringstream iss(arg.substr(10));
+				if (!(iss >> _timeoutMs)) {
+					std::cerr << "Error: Invalid timeout\n";
+					return false;
+				}
+			} else if (arg.rfind("--paste=", 0) == 0) {
+				_pasteFile = arg.substr(8);
+			} else if (arg == "--store-hex") {
+				_storeHex = true;
+			} else if (arg.rfind("--halt=", 0) == 0) {
+				std::istringstream iss(arg.substr(7));
+				if (!(iss >> std::hex >> _haltAddress)) {
+					std::cerr << "Error: Invalid halt address\n";
+					return false;
+				}
+				_haveHaltAddress = true;
+			} else {
+				std::cerr << "Error: Unknown option " << arg << "\n";
+				help();
+				return false;
+			}
+		}
+
+		if (_scriptFile.empty() && (!_outputFile.empty() || _timeoutMs)) {
+			std::cerr << "Error: --output and --timeout need --script\n";
+			return false;
+		}
+
+		if (_pasteFile.empty() && _storeHex) {
+			std::cerr << "Error: --store-hex needs --paste\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	// Returns false if the file can't be read
+	bool setupPaste() {
+		std::ifstream file(_pasteFile, std::ios::binary);
+		if (!file) {
+			std::cerr << "Error: Can't open " << _pasteFile << "\n";
+			return false;
+		}
+
+		std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		if (_storeHex)
+			text = WozMonDeposits<Address, Cell>(_mem).store(text);
+		text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+
+		_pia->paste(text);
+		return true;
+	}
+
+	// Load the script and send the display to the output file.  Returns the script, or nullptr if
+	// either can't be opened.
+	std::shared_ptr<KeyScript<Address, Cell>> setupHeadless() {
+		auto script = std::make_shared<KeyScript<Address, Cell>>(_pia, 1000 * CLOCK_MHZ);
+
+		std::ifstream file;
+		if (_scriptFile != "-") {
+			file.open(_scriptFile);
+			if (!file) {
+				std::cerr << "Error: Can't open script " << _scriptFile << "\n";
+				return nullptr;
+			}
+		}
+		if (!script->load(_scriptFile == "-" ? std::cin : file))
+			return nullptr;
+
+		FILE* output = stdout;
+		if (!_outputFile.empty() && !(output = fopen(_outputFile.c_str(), "w"))) {
+			std::cerr << "Error: Can't open output " << _outputFile << "\n";
+			return nullptr;
+		}
+
+		_pia->setHeadless(output);
+		script->setTimeout(_timeoutMs * 1000 * CLOCK_MHZ);
+		_bus.addDevice(script);
+		return script;
+	}
+
+	void setupMemoryMap() {
+		// 0x0000-0x5fff - RAM
+		// 0xe000-0xefff - Apple 1 Basic (also RAM)
+		// 0xd010-0xd013 - MOS6820
+		// 0xff00-0xffff - WozMon ROM
+
+		_mem.Reset();
+
+		// Map in the 6820/PIA, overwriting existing addresses.
+		_bus.addDevice(_pia, PIA_ADDRESS);
+
+		// Map the Wozmon ROM into memory
+		_mem.loadRomFromFile(WOZMON_FILE, WOZMON_ADDRESS);
+
+		// 8K RAM
+		_mem.mapRAM(0x0000, 0x1fff);
+		_mem.mapRAM(0x6000, 0x8fff);
+
+		// Map RAM and load Apple 1 basic
+		_mem.mapRAM(0xe000, 0xefff);
+		_mem.loadDataFromFile(BASIC_FILE, BASIC_ADDRESS);
+
+		// Load the sample program
+		_mem.loadData(_sampleProgram, SAMPLE_ADDRESS);
+	}
+};
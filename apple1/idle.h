@@ -0,0 +1,95 @@
+//
+// Detect the CPU idling in a keyboard polling loop
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "memory.h"
+
+//
+// A slice in which the CPU only polled an empty keyboard makes the machine a
+// suspect.  The next slice is then run with writes observed to the pages a
+// polling loop keeps its state in: zero page, the stack, and the page the
+// loop's code is on.  If that slice also only polled the keyboard and wrote
+// nothing there, the CPU is in a loop that can't change anything until a key
+// arrives.  The caller can block on input instead of running it.
+//
+// Only those pages leave the page table's fast path, and only while a
+// suspect slice runs.
+//
+template<class Address, class Cell>
+class IdleDetector : public MemoryObserver<Address, Cell>, public std::enable_shared_from_this<IdleDetector<Address, Cell>> {
+public:
+	IdleDetector(Memory<Address, Cell>& memory) : _mem(memory) { }
+
+	// Call after each slice with whether the keyboard saw only empty polls in it, and where the
+	// CPU is.  Returns true once the CPU is known to be idle.
+	bool check(const bool pollingIdle, const Address pc) {
+		if (!_verifying) {
+			if (pollingIdle) {
+				_writes = 0;
+				watch(pc);
+			}
+			return false;
+		}
+
+		unwatch();
+		return pollingIdle && _writes == 0;
+	}
+
+	// Stop watching, for when the caller runs the CPU some other way
+	void cancel() {
+		if (_verifying)
+			unwatch();
+	}
+
+	void observe(const std::span<const typename MemoryObserver<Address, Cell>::event> events) override {
+		_writes += events.size();
+	}
+
+private:
+	static constexpr Address STATE_END = 0x01ff;	// Zero page and the stack
+
+	Memory<Address, Cell>& _mem;
+	bool _verifying = false;
+	uint64_t _writes = 0;
+	std::array<std::pair<Address, Address>, 2> _watched;
+	size_t _ranges = 0;
+
+	void watch(const Address pc) {
+		const Address page = pc & ~Address(0xff);
+		_watched[0] = { 0, STATE_END };
+		_ranges = 1;
+		if (page > STATE_END)
+			_watched[_ranges++] = { page, Address(page | 0xff) };
+
+		for (size_t i = 0; i < _ranges; i++)
+			_mem.attachObserver(this->shared_from_this(), _watched[i].first, _watched[i].second, MemoryObserver<Address, Cell>::Write);
+		_verifying = true;
+	}
+
+	void unwatch() {
+		for (size_t i = 0; i < _ranges; i++)
+			_mem.detachObserver(this->shared_from_this(), _watched[i].first, _watched[i].second);
+		_verifying = false;
+	}
+};
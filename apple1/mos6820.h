@@ -20,14 +20,26 @@
 
 #pragma once
 
+#include <cerrno>
+#include <csignal>
 #include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <algorithm>
 
 #include "memory.h"
+#include "ring.h"
+#include "scheduler.h"
 
 #if defined(__linux__) || defined(__MACH__)
 #include <unistd.h>
+#include <poll.h>
 # ifdef __linux__
 #  include <termio.h>
 # endif
@@ -48,18 +60,125 @@ public:
 		this->_ioPorts = {KEYBOARD, KEYBOARDCR, DISPLAY, DISPLAYCR};
 	}
 
-  	Device::BusSignals housekeeping() override {
-		Device::BusSignals signals;
+	~MOS6820() {
+		stopReader();
+		flushDisplay();
+	}
+
+	// The keyboard is scanned every KEYBOARD_SCAN_CYCLES.  Characters written to the display are
+	// buffered and printed a line at a time, or DISPLAY_FLUSH_CYCLES after the first one.
+	void startEvents(EventScheduler& scheduler) override {
+		_scheduler = &scheduler;
+		scheduler.scheduleIn(*this, KEYBOARD_SCAN_CYCLES, KeyboardScan);
+	}
+
+	Device::Lines event(EventScheduler& scheduler, [[maybe_unused]] const uint64_t cycle, const int id) override {
+		switch (id) {
+		case KeyboardScan:
+			scheduler.scheduleIn(*this, KEYBOARD_SCAN_CYCLES, KeyboardScan);
+			return keyboardScan();
+		case DisplayFlush:
+			flushDisplay();
+			break;
+		}
 
-		signals.insert(displayHousekeeping());
-		signals.insert(keyboardHousekeeping());
-		return signals;
-}
+		return Device::None;
+	}
 
 	std::string type() const override { 
 		return fmt::format("MOS6820");
     }
 
+	// The terminal belongs to the emulator while it runs, and to the debugger otherwise
+	void setup() override {
+		if (!_headless)
+			setTermNonblocking();
+	}
+
+	void teardown() override {
+		if (_headless) {
+			flushDisplay();
+			fflush(_output);
+		} else
+			setTermBlocking();
+	}
+
+	// Run without a terminal.  Keys only come from type(), and the display is written to output.
+	void setHeadless(FILE* output) {
+		_headless = true;
+		_output = output;
+	}
+
+	// Press a key, as if it came from the keyboard.  Returns the line it asserts, if any.
+	Device::Lines type(const Cell key) {
+		return keyPressed(key);
+	}
+
+	bool keyboardEmpty() const {
+		return _charQueue.empty();
+	}
+
+	// Type text as fast as the CPU takes it.  Each key goes to the keyboard when the CPU reads
+	// the keyboard control register and finds it empty, so there's no waiting for a keyboard
+	// scan between keys.
+	void paste(const std::string_view text) {
+		_pasteBuffer.append(text);
+		if (_charQueue.empty())
+			pasteNext();
+	}
+
+	bool pasting() const {
+		return _pastePosition < _pasteBuffer.size();
+	}
+
+	// True if the CPU has found the keyboard empty since the last key was pressed
+	bool waitingForKey() const {
+		return _waitingForKey;
+	}
+
+	// What's been displayed since the last carriage return
+	const std::string& displayLine() const {
+		return _displayLine;
+	}
+
+	// True if, since the last call, the CPU has polled the keyboard control register and found
+	// it empty a number of times, and has done nothing else with the PIA.  That's what the Apple 1
+	// ROMs look like waiting for a key.
+	bool pollingIdle() {
+		const bool idle = _emptyPolls >= IDLE_POLLS && !_busy;
+		_emptyPolls = 0;
+		_busy = false;
+		return idle;
+	}
+
+	// Output waiting in the display buffer has already left the Apple 1, so it's printed rather
+	// than saved
+	void saveState(SnapshotWriter& snapshot) override {
+		flushDisplay();
+
+		snapshot.putTag("6820");
+		snapshot.put<uint8_t>(_kbdCRRead);
+
+		auto queue = _charQueue;
+		snapshot.put<uint32_t>(queue.size());
+		for (; !queue.empty(); queue.pop())
+			snapshot.put<Cell>(queue.front());
+	}
+
+	SnapshotRestore readState(SnapshotReader& snapshot) override {
+		snapshot.expectTag("6820");
+		const auto kbdCRRead = snapshot.get<uint8_t>();
+
+		decltype(_charQueue) queue;
+		for (auto count = snapshot.get<uint32_t>(); count; count--)
+			queue.push(snapshot.get<Cell>());
+
+		return [this, kbdCRRead, queue = std::move(queue)]() mutable {
+			_kbdCRRead = kbdCRRead;
+			_charQueue = std::move(queue);
+		};
+	}
+
 	Cell Read(const Address address) override {
 		auto port = this->decodeAddress(address);
 
@@ -108,10 +227,16 @@ public:
 		// Ignore ^C and ^-Backslash
 		signal(SIGINT, SIG_IGN);
 		signal(SIGQUIT, SIG_IGN);
+
+		resumeReader();
     }
 
+	// Stops the input thread too, so the debugger can read the terminal
     void setTermBlocking()
     {
+		pauseReader();
+		flushDisplay();
+
         termios term;
         tcgetattr(STDIN_FILENO, &term);
         term.c_lflag |= ICANON | ECHO | ISIG;
@@ -126,9 +251,12 @@ public:
 
 	void setTermNonblocking() {
 		SetConsoleCtrlHandler(ConsoleCtrlHandler, TRUE);
+		resumeReader();
 	}
 
 	void setTermBlocking() {
+		pauseReader();
+		flushDisplay();
 		SetConsoleCtrlHandler(ConsoleCtrlHandler, FALSE);
 	}
 
@@ -136,6 +264,16 @@ public:
 # error "No platform specific terminal functions"
 #endif
 
+	// Block until the input thread has a key or timeout passes.  Returns how long it waited.
+	std::chrono::nanoseconds waitForInput(const std::chrono::milliseconds timeout) {
+		flushDisplay();
+
+		const auto start = std::chrono::steady_clock::now();
+		std::unique_lock lock(_readerMutex);
+		_keyArrived.wait_for(lock, timeout, [this] { return !_keys.empty(); });
+		return std::chrono::steady_clock::now() - start;
+	}
+
 private:
 
 	// Offsets from MemMappedDevice::_baseAddress for these memory-mapped I/O ports.  These are in order
@@ -163,7 +301,7 @@ private:
 	static constexpr char CTRL_BACKSLASH  = 0x1c; // Reset/Jump to Wozmon
 	static constexpr char CTRL_RBRACKET   = 0x1d; // Enter debugger
 
-	// Platform agnostic remapping of control keycodes.  These are encoded in getch() and returned 
+	// Platform agnostic remapping of control keycodes.  These are encoded in decodeKey() and returned 
 	// as a Cell.  They must be non-printable ASCII characters on the Apple 1 (ie, extended 
 	// ASCII codes).
 	static constexpr Cell CLEAR_SCREEN  = 0xff;
@@ -171,45 +309,106 @@ private:
 	static constexpr Cell DEBUGGER      = 0xfd;
 	static constexpr Cell EXIT          = 0xfc;
 
+	// Scheduled events
+	enum { KeyboardScan, DisplayFlush };
+	static constexpr uint64_t KEYBOARD_SCAN_CYCLES = 1000;	// 1ms on an Apple 1
+	EventScheduler* _scheduler = nullptr;
+
 	// Display
-	bool _haveDspData = false;
-	unsigned char _dspData = 0;
+	//   Characters as the Apple 1 wrote them, translated and printed in one write
+	static constexpr size_t DISPLAY_BUFFER_SIZE = 1024;
+	static constexpr uint64_t DISPLAY_FLUSH_CYCLES = 20000;	// 20ms on an Apple 1
+	std::string _displayBuffer;
+	std::string _displayLine;
+	FILE* _output = stdout;
 	
 	// Keyboard
 	bool _kbdCRRead = false;
+	bool _waitingForKey = false;
+	bool _headless = false;
+
+	// Paste
+	//   Keys waiting to go to the keyboard, one at a time.  Keys from the terminal come through
+	//   here too, so pasting into the terminal gets the same treatment.
+	std::string _pasteBuffer;
+	size_t _pastePosition = 0;
 	std::queue<Cell> _charQueue;
 
+	// Keyboard input thread
+	//   The reader blocks on the terminal and passes decoded keys to the CPU's thread through
+	//   _keys, which the keyboard scan drains, so running the CPU makes no system calls.  The
+	//   reader is paused while the debugger has the terminal.
+	enum class ReaderState { Paused, Running, Stopping };
+	static constexpr size_t KEY_RING_SIZE = 256;
+	SPSCRing<Cell, KEY_RING_SIZE> _keys;
+	std::thread _reader;
+	std::mutex _readerMutex;
+	std::condition_variable _readerChanged;		// The state changed or the reader parked
+	std::condition_variable _keyArrived;
+	std::atomic<ReaderState> _readerState = ReaderState::Paused;
+	bool _readerParked = true;					// Not reading the terminal
+	bool _endOfInput = false;
+
+	// Idle detection
+	static constexpr uint32_t IDLE_POLLS = 8;
+	uint32_t _emptyPolls = 0;	// Reads of KBDCR with no key waiting
+	bool _busy = false;			// Any other use of the PIA
+
 #if defined(__linux__) || defined(__MACH__)
-    
-     bool getch(Cell &kbdCh) const {
-        int byteswaiting;
-        char ch;
 
-        ioctl(STDIN_FILENO, FIONREAD, &byteswaiting);
-        if (byteswaiting == 0)
-            return false;
+	int _wakePipe[2] = { -1, -1 };		// Written to get the reader out of poll()
 
-        read(STDIN_FILENO, &ch, 1);
-		
+	bool openReader() {
+		return pipe(_wakePipe) == 0;
+	}
+
+	void closeReader() {
+		close(_wakePipe[0]);
+		close(_wakePipe[1]);
+	}
+
+	void wakeReader() {
+		const char c = 0;
+		[[maybe_unused]] auto written = write(_wakePipe[1], &c, 1);
+	}
+
+	// Block until there are keys on stdin or the reader is woken.  Returns false at the end of
+	// input.
+	bool readKeys() {
+		pollfd fds[2] = { { STDIN_FILENO, POLLIN, 0 }, { _wakePipe[0], POLLIN, 0 } };
+		if (poll(fds, 2, -1) < 0)
+			return true;
+
+		if (fds[1].revents & POLLIN) {
+			char c;
+			[[maybe_unused]] auto wakeups = read(_wakePipe[0], &c, 1);
+			return true;
+		}
+
+		char buffer[64];
+		const auto n = read(STDIN_FILENO, buffer, sizeof(buffer));
+		if (n < 0)
+			return errno == EINTR || errno == EAGAIN;
+
+		for (ssize_t i = 0; i < n; i++)
+			pushKey(decodeKey(buffer[i]));
+		return n > 0;
+	}
+
+	Cell decodeKey(const char ch) const {
 		switch (ch) {
 		case CTRL_BACKSPACE:
-			kbdCh = EXIT;
-			break;
+			return EXIT;
 		case CTRL_BACKSLASH:
-			kbdCh = RESET;
-			break;
+			return RESET;
 		case CTRL_RBRACKET:
-			kbdCh = DEBUGGER;
-			break;
+			return DEBUGGER;
 		case CTRL_LBRACKET:
-			kbdCh = CLEAR_SCREEN;
-			break;
+			return CLEAR_SCREEN;
 		default:
-	        kbdCh = ch;
-			break;
+			return ch;
 		}
-        return true;
-    }
+	}
 
 	void clearScreen() const {
 		const std::string CLS = "\033[2J\033[H"; 
@@ -234,76 +433,204 @@ private:
 		system("cls");
 	}
 
-	bool getch(Cell& kbdCh) const {
-		
+	bool openReader() {
+		return true;
+	}
+
+	void closeReader() { }
+
+	// The reader never blocks for long, so there's nothing to wake
+	void wakeReader() { }
+
+	bool readKeys() {
+		WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), 50);
+
 		if (_CtrlC_Pressed) {
 			_CtrlC_Pressed = false;
-			kbdCh = CTRL_C;
-			return true;
+			pushKey(CTRL_C);
 		}
 
-		if (!_kbhit()) 
-			return false;
-		
-		auto c = _getch();
+		while (_kbhit())
+			pushKey(decodeKey(_getch()));
+		return true;
+	}
+
+	Cell decodeKey(const int c) const {
 		if (GetAsyncKeyState(VK_CONTROL) < 0) { // Control was held when key was pressed
 			switch (c) {
 			case CTRL_BACKSPACE:
-				kbdCh = EXIT;
-				return true;
+				return EXIT;
 			case CTRL_BACKSLASH:
-				kbdCh = RESET;
-				return true;
+				return RESET;
 			case CTRL_LBRACKET:
-				kbdCh = CLEAR_SCREEN;
-				return true;
+				return CLEAR_SCREEN;
 			case CTRL_RBRACKET:
-				kbdCh = DEBUGGER;
-				return true;
+				return DEBUGGER;
 			}
 		}
-	
-		kbdCh = c;
-		return true;
+
+		return c;
     }
 
 #else
-# error "No platform specific clearScreen() or getch() functions defined"
+# error "No platform specific clearScreen() or readKeys() functions defined"
 #endif
 
-	Device::Lines displayHousekeeping() {
-		if (!_haveDspData) 
-			return Device::None;
+	void resumeReader() {
+		if (!_reader.joinable()) {
+			if (!openReader())
+				return;
+			_reader = std::thread(&MOS6820::readerLoop, this);
+		}
+
+		std::lock_guard lock(_readerMutex);
+		_readerState = ReaderState::Running;
+		_readerChanged.notify_all();
+	}
+
+	// Returns once the reader is off the terminal
+	void pauseReader() {
+		std::unique_lock lock(_readerMutex);
+		if (_readerState != ReaderState::Running)
+			return;
+
+		_readerState = ReaderState::Paused;
+		wakeReader();
+		_readerChanged.wait(lock, [this] { return _readerParked; });
+	}
 
-		auto c = _dspData & 0x7f;	// clear hi bit
+	void stopReader() {
+		if (!_reader.joinable())
+			return;
+
+		{
+			std::lock_guard lock(_readerMutex);
+			_readerState = ReaderState::Stopping;
+			wakeReader();
+			_readerChanged.notify_all();
+		}
+		_reader.join();
+		closeReader();
+	}
+
+	void readerLoop() {
+		std::unique_lock lock(_readerMutex);
+		for (;;) {
+			_readerParked = true;
+			_readerChanged.notify_all();
+			_readerChanged.wait(lock, [this] {
+				return _readerState == ReaderState::Stopping || (_readerState == ReaderState::Running && !_endOfInput);
+			});
+			if (_readerState == ReaderState::Stopping)
+				return;
+			_readerParked = false;
+
+			lock.unlock();
+			const bool more = readKeys();
+			lock.lock();
+			_endOfInput = !more;
+		}
+	}
+
+	// Reader side.  If the CPU isn't taking keys, wait for room rather than lose them, unless
+	// the reader is being paused.
+	void pushKey(const Cell key) {
+		while (!_keys.push(key)) {
+			if (_readerState != ReaderState::Running)
+				return;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		std::lock_guard lock(_readerMutex);
+		_keyArrived.notify_all();
+	}
+
+	void flushDisplay() {
+		if (_displayBuffer.empty())
+			return;
+
+		std::string text;
+		text.reserve(_displayBuffer.size());
+		for (const unsigned char d : _displayBuffer)
+			if (const auto c = displayChar(d))
+				text += c;
+
+		_displayBuffer.clear();
+		fmt::print(_output, "{}", text);
+	}
+
+	// The host character for one the Apple 1 displays, or 0 if it has none
+	static char displayChar(const Cell d) {
+		const auto c = d & 0x7f;	// clear hi bit
 		switch (c) {
 		case CARRIAGE_RETURN:
-			fmt::print("\n");
-			break;
+			return '\n';
 		case BACKSPACE:
-			fmt::print("\b");
-			break;
+			return '\b';
 		case BELL:
-			fmt::print("\a");
-			break;
+			return '\a';
 		default:
 			if (c >= 0x20 && c <= 0x7e)
-				fmt::print("{:c}", toupper(c));
+				return static_cast<char>(toupper(c));
 		}
 
-		_haveDspData = false;
-		return Device::None;
+		return 0;
 	}
 
-	Device::Lines keyboardHousekeeping() {
+	// Take the keys the reader has decoded into the paste buffer, stopping at one that asserts a
+	// line.  Control-C and the emulator's control keys act straight away.  Anything waiting to be
+	// displayed is printed first, so what's typed follows it.
+	Device::Lines keyboardScan() {
+		if (_keys.empty())
+			return Device::None;
+
+		flushDisplay();
+
 		Cell ch;
+		auto line = Device::None;
+		while (line == Device::None && _keys.pop(ch)) {
+			switch (ch) {
+			case CTRL_C:
+				discardPaste();
+				[[fallthrough]];
+			case RESET:
+			case DEBUGGER:
+			case EXIT:
+			case CLEAR_SCREEN:
+				line = keyPressed(ch);
+				break;
+			default:
+				_pasteBuffer.push_back(static_cast<char>(ch));
+			}
+		}
+
+		if (_charQueue.empty())
+			pasteNext();
+		return line;
+	}
+
+	// Move the next key of the paste buffer to the keyboard.  Returns false if there isn't one.
+	bool pasteNext() {
+		while (pasting()) {
+			keyPressed(static_cast<unsigned char>(_pasteBuffer[_pastePosition++]));
+			if (!_charQueue.empty())
+				break;
+		}
+
+		if (!pasting())
+			discardPaste();
+		return !_charQueue.empty();
+	}
+
+	void discardPaste() {
+		_pasteBuffer.clear();
+		_pastePosition = 0;
+	}
+
+	Device::Lines keyPressed(Cell ch) {
 		bool clobberQueue = false;
         auto retval = Device::None;
 
-        auto charsPending = getch(ch);
-		if (!charsPending)
-			return retval;
-		
 		// Handle control characters or map modern ascii to Apple 1 keycodes
 		switch (ch) {
 
@@ -315,9 +642,11 @@ private:
 			return Device::Debug;
 
         case EXIT: 
+			flushDisplay();
 			return Device::Exit;
 		
 		case CLEAR_SCREEN:
+			flushDisplay();
 			clearScreen();
 			return Device::None;
 
@@ -345,6 +674,8 @@ private:
 				_charQueue.pop();
 
 		_charQueue.push(ch);
+		_busy = true;
+		_waitingForKey = false;
 
         return retval;
 	}
@@ -352,12 +683,27 @@ private:
 	void displayWrite(const uint8_t port, const Cell c) {
 		switch (port) {
 		case DISPLAY:
-			_dspData = c;
-			_haveDspData = true;
+			_displayBuffer.push_back(static_cast<char>(c));
+			_busy = true;
+			trackDisplayLine(c);
+			if ((c & 0x7f) == CARRIAGE_RETURN || _displayBuffer.size() >= DISPLAY_BUFFER_SIZE)
+				flushDisplay();
+			else if (_displayBuffer.size() == 1 && _scheduler && !_scheduler->isScheduled(*this, DisplayFlush))
+				_scheduler->scheduleIn(*this, DISPLAY_FLUSH_CYCLES, DisplayFlush);
 			break;
 		}
 	}
 
+	void trackDisplayLine(const Cell c) {
+		const auto ch = displayChar(c);
+		if (ch == '\n')
+			_displayLine.clear();
+		else if (ch == '\b' && !_displayLine.empty())
+			_displayLine.pop_back();
+		else if (ch >= 0x20 && _displayLine.size() < DISPLAY_BUFFER_SIZE)
+			_displayLine += ch;
+	}
+
 	Cell displayRead(const uint8_t port) const {
 		switch (port) {
 		case DISPLAY:
@@ -376,12 +722,17 @@ private:
 		case KEYBOARDCR:
 			// Check if characters are pending, return key code if so
 			_kbdCRRead = true;
-			if (_charQueue.empty())
+			if (_charQueue.empty() && !pasteNext()) {
+				_emptyPolls++;
+				_waitingForKey = true;
 				return 0;
+			}
 
+			_busy = true;
 			return _charQueue.front();
 
 		case KEYBOARD:
+			_busy = true;
 			if (_charQueue.empty())
 				return 0;
 
@@ -395,7 +746,7 @@ private:
 			// infinite loop.  This also means that if the user hits ^C but the data element
 			// at the head of _charQueue is something else, the ^C will never be seen and processed.
 			// We fix this by clobbering the _charQueue before queuing the ^C.  We do this in 
-			// keyboardHousekeeping() above.
+			// keyPressed() above.
 			if (_kbdCRRead) {
 				_charQueue.pop();
 				_kbdCRRead = false;
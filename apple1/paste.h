@@ -0,0 +1,120 @@
+//
+// Store WozMon deposit lines straight into memory
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "memory.h"
+
+//
+// WozMonDeposits takes text about to be pasted into WozMon, such as what
+// tools/bin2hex produces, and writes the lines that only deposit bytes
+// ("0300: A9 00 AA", or ": 20 EF FF" to carry on from the line before) into
+// memory in one block each.  The rest of the text is left to be typed.
+//
+// WozMon never sees the deposits, so a typed command that relies on the
+// address it last opened, like a bare "R", has to name the address instead.
+//
+template<class Address, class Cell>
+class WozMonDeposits {
+public:
+	WozMonDeposits(Memory<Address, Cell>& memory) : _mem(memory) { }
+
+	// Returns the lines that aren't deposits
+	std::string store(const std::string_view text) {
+		std::string rest;
+
+		for (size_t start = 0; start < text.size(); ) {
+			auto end = text.find('\n', start);
+			end = end == std::string_view::npos ? text.size() : end + 1;
+			const auto line = text.substr(start, end - start);
+			start = end;
+
+			if (!deposit(line))
+				rest.append(line);
+		}
+
+		return rest;
+	}
+
+	// Cells stored so far
+	size_t stored() const {
+		return _stored;
+	}
+
+private:
+	Memory<Address, Cell>& _mem;
+	Address _next = 0;			// Where a line starting with ':' deposits
+	size_t _stored = 0;
+
+	// Returns false, storing nothing, if line isn't a deposit
+	bool deposit(const std::string_view line) {
+		size_t i = 0;
+		uint32_t address;
+
+		skipSpaces(line, i);
+		const auto digits = hex(line, i, address);
+		if (digits > 4)
+			return false;
+		if (digits == 0)
+			address = _next;
+
+		skipSpaces(line, i);
+		if (i == line.size() || line[i++] != ':')
+			return false;
+
+		std::vector<Cell> data;
+		for (;;) {
+			skipSpaces(line, i);
+			if (i == line.size())
+				break;
+
+			uint32_t value;
+			const auto n = hex(line, i, value);
+			if (n == 0 || n > 2)
+				return false;
+			data.push_back(static_cast<Cell>(value));
+		}
+
+		_mem.writeBlock(static_cast<Address>(address), data);
+		_next = static_cast<Address>(address + data.size());
+		_stored += data.size();
+		return true;
+	}
+
+	static void skipSpaces(const std::string_view line, size_t& i) {
+		while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+			i++;
+	}
+
+	// Reads hex digits at i into value.  Returns how many there were.
+	static size_t hex(const std::string_view line, size_t& i, uint32_t& value) {
+		size_t digits = 0;
+		value = 0;
+		for (; i < line.size() && std::isxdigit(static_cast<unsigned char>(line[i])); i++, digits++) {
+			const auto c = std::tolower(static_cast<unsigned char>(line[i]));
+			value = (value << 4) | (c <= '9' ? c - '0' : c - 'a' + 10);
+		}
+		return digits;
+	}
+};
@@ -0,0 +1,185 @@
+//
+// Scripted keyboard input for running the Apple 1 without a terminal
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fmt/core.h>
+
+#include "memory.h"
+#include "scheduler.h"
+#include "mos6820.h"
+
+//
+// A KeyScript types into the PIA's keyboard, one key at a time as the Apple 1
+// takes them, by pasting unless there's a delay between keys.  Each line of
+// the script is typed followed by a carriage return, except for lines
+// starting with '@', which are directives:
+//
+//   @prompt <text>   Wait until the Apple 1 is waiting for a key with <text>
+//                    at the end of the line it's displaying.  With no <text>,
+//                    just wait until it's waiting for a key.
+//   @wait <ms>       Wait <ms> milliseconds of emulated time
+//   @keydelay <ms>   Wait <ms> milliseconds of emulated time between keys
+//   @@...            Type the line starting with a single '@'
+//
+// Times are emulated, not real, so a script runs the same however fast the
+// emulator does.  The script asserts Exit when it ends, so it should end by
+// waiting for whatever its last line produces.  It also asserts Exit if it
+// runs past its timeout.
+//
+template<class Address, class Cell>
+class KeyScript : public Device {
+public:
+	enum Status { Completed = 0, TimedOut = 2 };
+
+	KeyScript(std::shared_ptr<MOS6820<Address, Cell>> keyboard, const uint64_t cyclesPerMs) :
+		_pia(std::move(keyboard)), _cyclesPerMs(cyclesPerMs) { }
+
+	// Returns false, after saying why, if the script has a bad directive
+	bool load(std::istream& in) {
+		std::string line;
+		for (int number = 1; std::getline(in, line); number++) {
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if (line.empty() || line[0] != '@' || line.starts_with("@@")) {
+				_steps.push_back({ Type, 0, (line.starts_with("@@") ? line.substr(1) : line) + '\n' });
+				continue;
+			}
+
+			const auto space = line.find(' ');
+			const auto directive = line.substr(1, space == std::string::npos ? std::string::npos : space - 1);
+			const auto argument = space == std::string::npos ? std::string() : line.substr(space + 1);
+
+			if (directive == "prompt") {
+				_steps.push_back({ Prompt, 0, argument });
+			} else if (directive == "wait" || directive == "keydelay") {
+				uint64_t ms;
+				try {
+					ms = std::stoull(argument);
+				} catch (...) {
+					fmt::print(stderr, "Script line {}: @{} needs a time in milliseconds\n", number, directive);
+					return false;
+				}
+				_steps.push_back({ directive == "wait" ? Wait : KeyDelay, ms * _cyclesPerMs, {} });
+			} else {
+				fmt::print(stderr, "Script line {}: unknown directive '@{}'\n", number, directive);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Give up after this many cycles.  0 waits forever.
+	void setTimeout(const uint64_t cycles) {
+		_timeout = cycles;
+	}
+
+	Status status() const {
+		return _status;
+	}
+
+	void startEvents(EventScheduler& scheduler) override {
+		scheduler.scheduleIn(*this, POLL_CYCLES, Next);
+		if (_timeout)
+			scheduler.scheduleIn(*this, _timeout, Timeout);
+	}
+
+	Device::Lines event(EventScheduler& scheduler, [[maybe_unused]] const uint64_t cycle, const int id) override {
+		if (id == Timeout) {
+			_status = TimedOut;
+			return Device::Exit;
+		}
+
+		for (; _step < _steps.size(); _step++) {
+			const auto& s = _steps[_step];
+
+			switch (s.kind) {
+			case Type:
+				// The Apple 1 takes one key at a time
+				if (_pia->pasting() || !_pia->keyboardEmpty()) {
+					scheduler.scheduleIn(*this, POLL_CYCLES, Next);
+					return Device::None;
+				}
+
+				// With no delay between keys, the line is pasted
+				if (_keyDelay == 0 && _position == 0) {
+					_pia->paste(s.text);
+					break;
+				}
+
+				scheduler.scheduleIn(*this, std::max(_keyDelay, POLL_CYCLES), Next);
+				{
+					const Cell key = s.text[_position++];
+					if (_position == s.text.size()) {
+						_position = 0;
+						_step++;
+					}
+					return _pia->type(key);
+				}
+
+			case Prompt:
+				if (!_pia->waitingForKey() || !_pia->displayLine().ends_with(s.text)) {
+					scheduler.scheduleIn(*this, POLL_CYCLES, Next);
+					return Device::None;
+				}
+				break;
+
+			case Wait:
+				_step++;
+				scheduler.scheduleIn(*this, std::max(s.cycles, POLL_CYCLES), Next);
+				return Device::None;
+
+			case KeyDelay:
+				_keyDelay = s.cycles;
+				break;
+			}
+		}
+
+		_status = Completed;
+		return Device::Exit;
+	}
+
+private:
+	enum Kind { Type, Prompt, Wait, KeyDelay };
+	struct step {
+		Kind kind;
+		uint64_t cycles;
+		std::string text;
+	};
+
+	// Scheduled events
+	enum { Next, Timeout };
+	static constexpr uint64_t POLL_CYCLES = 100;	// How often to check whether the Apple 1 is ready
+
+	std::shared_ptr<MOS6820<Address, Cell>> _pia;
+	uint64_t _cyclesPerMs;
+	std::vector<step> _steps;
+	size_t _step = 0;
+	size_t _position = 0;			// Next key of a Type step
+	uint64_t _keyDelay = 0;
+	uint64_t _timeout = 0;
+	Status _status = Completed;
+};
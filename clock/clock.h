@@ -25,9 +25,46 @@
 using namespace std::chrono_literals;
 using freq_t = uint16_t;
 
-class BusClock_t {
+// The time source the bus clock paces against: the steady clock, sleeping the calling thread
+struct SteadyClock : std::chrono::steady_clock {
+	static void sleep_until(const time_point t) { std::this_thread::sleep_until(t); }
+};
+
+//
+// The bus clock paces emulation against real time.  Every cycle run moves an
+// absolute deadline on the steady clock forward by one cycle time.  Once a
+// slice's worth of cycles has run, delay() sleeps until just short of the
+// deadline and spins the rest of the way, so errors in one sleep don't
+// accumulate into drift.
+//
+// When emulation falls behind (the host was busy, or the debugger had the
+// CPU) the catch up policy decides what happens to the lag: Burst runs
+// without sleeping until it's made up, up to a limit, and Skip forgets it
+// and paces from now.
+//
+// Clock supplies now() and sleep_until(); tests substitute one they control.
+//
+template<class Clock = SteadyClock>
+class BasicBusClock {
 public:
-	BusClock_t(freq_t MHz) : _emulateTiming(true) {
+	using clock_t = Clock;
+	using time_point = typename Clock::time_point;
+
+	enum class CatchUp {
+		Burst,		// Run flat out to make up lag, forgetting any beyond the maximum
+		Skip		// Forget lag
+	};
+
+	struct stats {
+		double effectiveMHz = 0;						// Cycles run over the real time taken
+		std::chrono::nanoseconds drift{0};				// How far real time was past the deadline at the last delay
+		std::chrono::nanoseconds averageOversleep{0};	// How late sleeps woke, on average...
+		std::chrono::nanoseconds maximumOversleep{0};	// ...and at worst
+		std::chrono::nanoseconds skipped{0};			// Lag forgotten by the catch up policy
+		uint64_t delays = 0;							// Times delay() paced to the deadline
+	};
+
+	BasicBusClock(freq_t MHz) : _emulateTiming(true) {
 		_MHz = std::clamp(MHz, _MIN_MHz, _MAX_MHz);
 		_cyclesInDelayTime = _delayMs.count() * _MHz * _cyclesPerMsAt1MHz;
 		_accumulatedCycles = 0;
@@ -36,6 +73,7 @@ public:
 	void enableTimingEmulation() {
 		_emulateTiming = true;
 		_accumulatedCycles = 0;
+		restart();
 	}
 	
 	void disableTimingEmulation() {
@@ -45,11 +83,12 @@ public:
 
 	bool delay(const uint64_t cycles = 1) {
 		_accumulatedCycles += cycles;
+		_cycles += cycles;
 
 		if (_accumulatedCycles >= _cyclesInDelayTime) {
 			_accumulatedCycles -= _cyclesInDelayTime;
 			if (_emulateTiming) {
-				std::this_thread::sleep_for(_delayMs);
+				pace();
 				return true;
 			}
 		} 
@@ -65,14 +104,108 @@ public:
 
 	uint64_t getCyclesInDelayTime() { return _cyclesInDelayTime; }
 
+	// Count time the machine spent blocked waiting for input as emulated time, so it isn't made
+	// up afterwards as lag.  Returns the cycles that time is worth.
+	uint64_t advance(const std::chrono::nanoseconds elapsed) {
+		const uint64_t cycles = elapsed.count() * _MHz / 1000;
+		_cycles += cycles;
+		return cycles;
+	}
+
+	// Pacing policy
+	void setCatchUpPolicy(const CatchUp policy)				{ _catchUp = policy; }
+	CatchUp getCatchUpPolicy()								{ return _catchUp; }
+	void setMaximumLag(const std::chrono::nanoseconds lag)	{ _maximumLag = lag; }
+	std::chrono::nanoseconds getMaximumLag()				{ return _maximumLag; }
+	void setSpinTime(const std::chrono::nanoseconds spin)	{ _spinTime = spin; }
+	std::chrono::nanoseconds getSpinTime()					{ return _spinTime; }
+
+	stats getStats() {
+		stats s = _stats;
+		const auto elapsed = std::chrono::duration<double, std::micro>(clock_t::now() - _statsStart).count();
+		s.effectiveMHz = (_started && elapsed > 0) ? (_cycles - _statsCycles) / elapsed : 0;
+		if (_sleeps)
+			s.averageOversleep = _totalOversleep / _sleeps;
+		return s;
+	}
+
+	void resetStats() {
+		_stats = {};
+		_totalOversleep = 0ns;
+		_sleeps = 0;
+		_statsStart = clock_t::now();
+		_statsCycles = _cycles;
+	}
+
 private:
 	bool _emulateTiming;
 	freq_t _MHz;
 	uint64_t _accumulatedCycles = 0;
 	uint64_t _cyclesInDelayTime;
 
+	// Deadlines are _epoch plus the time _cycles take at _MHz.  The epoch is set by the first
+	// delay after timing starts, so time spent setting up isn't counted as lag.
+	bool _started = false;
+	time_point _epoch;
+	uint64_t _cycles = 0;
+
+	CatchUp _catchUp = CatchUp::Burst;
+	std::chrono::nanoseconds _maximumLag = 100ms;
+	std::chrono::nanoseconds _spinTime = 100us;		// Spun rather than slept at the end of a delay
+
+	stats _stats;
+	std::chrono::nanoseconds _totalOversleep{0};
+	uint64_t _sleeps = 0;
+	time_point _statsStart;
+	uint64_t _statsCycles = 0;
+
 	static constexpr freq_t _MIN_MHz = 1;
 	static constexpr freq_t _MAX_MHz = 1000;
 	static constexpr uint64_t _cyclesPerMsAt1MHz = 1000;	
-	static constexpr std::chrono::milliseconds _delayMs = 15ms; // needs to be large enough so that ::sleep_for() is reasonably precise 
+	static constexpr std::chrono::milliseconds _delayMs = 5ms; // How often delay() paces to the deadline
+
+	void restart() {
+		_started = false;
+		_cycles = 0;
+		resetStats();
+	}
+
+	time_point deadline() const {
+		return _epoch + std::chrono::nanoseconds(_cycles * 1000 / _MHz);
+	}
+
+	void pace() {
+		auto now = clock_t::now();
+		if (!_started) {
+			_started = true;
+			_epoch = now - std::chrono::nanoseconds(_cycles * 1000 / _MHz);
+			_statsStart = _epoch;
+			_statsCycles = 0;
+		}
+
+		_stats.delays++;
+		auto target = deadline();
+
+		if (now >= target) {
+			auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(now - target);
+			auto forget = _catchUp == CatchUp::Skip ? lag : std::max(lag - _maximumLag, 0ns);
+			_epoch += forget;
+			_stats.skipped += forget;
+			_stats.drift = lag - forget;
+			return;
+		}
+
+		if (target - now > _spinTime)
+			clock_t::sleep_until(target - _spinTime);
+		while ((now = clock_t::now()) < target)
+			;
+
+		const auto oversleep = std::chrono::duration_cast<std::chrono::nanoseconds>(now - target);
+		_totalOversleep += oversleep;
+		_sleeps++;
+		_stats.maximumOversleep = std::max(_stats.maximumOversleep, oversleep);
+		_stats.drift = oversleep;
+	}
 };
+
+using BusClock_t = BasicBusClock<>;
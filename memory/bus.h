@@ -0,0 +1,137 @@
+//
+// The bus connecting a CPU to its memory and devices
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <memory.h>
+#include <scheduler.h>
+
+//
+// A Bus owns a machine's devices and the scheduler that times their events.
+// step() runs the CPU until the next device event is due, or for one
+// debugger command, runs the events that came due and then acts on the lines
+// the devices asserted: reset, the debugger, IRQ and exiting the emulator.
+// Lines are collected in a bitmask while the events run, so a step with no
+// lines asserted only tests one word.
+//
+// Devices are set up when the machine starts, and torn down when it stops
+// and around each debugger command so the debugger can have the terminal.
+//
+template<class CPU, class Address, class Cell>
+class Bus {
+public:
+	Bus(CPU& processor, Memory<Address, Cell>& memory, const EventScheduler::Cycles slice) :
+		_cpu(processor), _mem(memory), _scheduler(slice) {
+		_scheduler.setPreemption([this] { _cpu.stop(); });
+	}
+
+	// Map a device into memory at base and start its events
+	void addDevice(const std::shared_ptr<MemMappedDevice<Address, Cell>>& device, const Address base) {
+		_mem.mapDevice(device, base);
+		_devices.push_back(device);
+		_scheduler.addDevice(device);
+	}
+
+	// Start the events of a device that isn't mapped into memory
+	void addDevice(const std::shared_ptr<Device>& device) {
+		_devices.push_back(device);
+		_scheduler.addDevice(device);
+	}
+
+	void setup() {
+		for (auto& d : _devices)
+			d->setup();
+	}
+
+	void teardown() {
+		for (auto& d : _devices)
+			d->teardown();
+	}
+
+	// Returns the cycles the CPU used
+	uint64_t step() {
+		uint64_t cycles;
+
+		if (_cpu.isInDebugMode()) {
+			teardown();
+			_cpu.execute();
+			setup();
+			cycles = _cpu.usedCycles();
+		} else {
+			cycles = _cpu.run(_scheduler.nextSlice());
+		}
+
+		_scheduler.advance(cycles);
+		_scheduler.dispatch([this](const Device::Lines line) { _signals |= Device::signal(line); });
+		if (_signals) [[unlikely]]
+			handleSignals();
+
+		return cycles;
+	}
+
+	// Time passed without the CPU running, such as waiting for input
+	void advance(const EventScheduler::Cycles cycles) {
+		_scheduler.advance(cycles);
+	}
+
+	// A device asked to leave the emulator
+	bool exiting() const {
+		return _exiting;
+	}
+
+	EventScheduler& scheduler() {
+		return _scheduler;
+	}
+
+private:
+	CPU& _cpu;
+	Memory<Address, Cell>& _mem;
+	EventScheduler _scheduler;
+	std::vector<std::shared_ptr<Device>> _devices;
+	Device::Signals _signals = 0;
+	bool _exiting = false;
+
+	// In order of precedence, lowest line first
+	void handleSignals() {
+		for (; _signals; _signals &= _signals - 1) {
+			switch (static_cast<Device::Lines>(std::countr_zero(_signals))) {
+			case Device::Debug:
+				_cpu.setDebugMode(true);
+				break;
+			case Device::Exit:
+				_exiting = true;
+				break;
+			case Device::Reset:
+				_cpu.Reset();
+				if (_cpu.inReset())
+					_cpu.Reset();
+				break;
+			case Device::IRQ:
+				_cpu.raiseIRQ();
+				break;
+			case Device::None:
+				break;
+			}
+		}
+	}
+};
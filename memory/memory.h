@@ -21,6 +21,7 @@
 #include <set>
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <iostream>
 #include <stack>
@@ -28,16 +29,37 @@
 #include <sstream>
 #include <cctype>
 #include <unordered_map>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 #include <fmt/core.h>
 
+#include <memsearch.h>
+#include <observer.h>
+#include <snapshot.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+# define MEMORY_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 //
-// Memory is a simple vector of Elements, where each element is a
-// storage container for a Cell.  Elements are of five different
-// types: Unmapped, RAM, ROM, MIO (memory-mapped I/O) and MemMappedDevice. 
+// Memory is a set of regions, contiguous address ranges that are each
+// handled by one Element.  Elements are of five different types:
+// Unmapped, RAM, ROM, MIO (memory-mapped I/O) and MemMappedDevice. 
 // Unmapped elements are represented by the base Element class.  RAM, ROM, 
 // MIO and MemMappedDevice are represented by their own derived class.
 //
 // Each element is organized and accessed via the Memory class.
+//
+// RAM and ROM cells live in one contiguous vector owned by Memory, and
+// a page table points pages made up only of RAM and ROM straight at it.
+// Reads and writes to those pages don't go through the elements at all.
 // 
 
 /////////
@@ -60,26 +82,19 @@ public:
 	}
 };
 
-// RAM element
+// RAM element, a view of the cells Memory keeps for every address
 template<class Address, class Cell>
 class RAM : public Element<Address, Cell> {
 public:
-	RAM() { 
-		_cell = 0;
+	RAM(std::vector<Cell>& cells) : _cells(cells) { 
 	}
 
-	RAM<Address, Cell>& operator=(const Cell i) {
-		Write(i);
-		return *this;
+	Cell Read(const Address address) override {
+		return _cells[address];
 	}
 
-	Cell Read([[maybe_unused]] const Address address) override {
-		return _cell;
-	}
-
-	void Write([[maybe_unused]] const Address address,
-		const Cell b) override {
-		_cell = b;
+	void Write(const Address address, const Cell b) override {
+		_cells[address] = b;
 	}
 
 	std::string type() const override{
@@ -87,20 +102,42 @@ public:
 	}
 
 private:
-	Cell _cell;
+	std::vector<Cell>& _cells;
 };
 
-// ROM element
+// ROM element, a read-only view of the cells Memory keeps for every address
 template<class Address, class Cell>
 class ROM : public Element<Address, Cell> {
 public:
 	
-	ROM(Cell value) {
-		_cell = value;
+	ROM(std::vector<Cell>& cells) : _cells(cells) {
 	}
 
-	Cell Read([[maybe_unused]] const Address address) override {
-		return _cell;
+	Cell Read(const Address address) override {
+		return _cells[address];
+	}
+
+	void Write([[maybe_unused]] const Address address, [[maybe_unused]] const Cell  b) override {
+	}
+
+	std::string type() const override {
+		return "ROM";
+	}
+
+private:
+	std::vector<Cell>& _cells;
+};
+
+// ROM element backed by a file image mapped into the host's memory.  Every
+// machine that loads the same file shares the host's copy of it.
+template<class Address, class Cell>
+class MappedROM : public Element<Address, Cell> {
+public:
+	MappedROM(std::shared_ptr<const Cell> image, const Address base) : _image(image), _base(base) {
+	}
+
+	Cell Read(const Address address) override {
+		return _image.get()[address - _base];
 	}
 
 	void Write([[maybe_unused]] const Address address, [[maybe_unused]] const Cell  b) override {
@@ -110,8 +147,133 @@ public:
 		return "ROM";
 	}
 
+	// Host pointer to the cell for address
+	const Cell* cells(const Address address) const {
+		return _image.get() + (address - _base);
+	}
+
+private:
+	std::shared_ptr<const Cell> _image;
+	Address _base;
+};
+
+// Banked memory, a window of size cells that shows one of several banks of RAM
+// or ROM, such as a 16K window into 512K of RAM or ROM overlays above e000.
+// Memory points the window's pages straight at the selected bank, so select()
+// costs a page table update however large the banks are.  The banks keep their
+// contents and selection across Memory::Reset().
+template<class Address, class Cell>
+class BankedMemory : public Element<Address, Cell> {
+public:
+	using remapfn_t = std::function<void(Address, Address)>;
+
+	BankedMemory(const Address size, const size_t banks, const bool writable = true) :
+		_size(size), _banks(banks), _writable(writable), _cells(uint64_t(size) * banks, Cell(0)) {
+	}
+
+	// Copy data into bank, from the start of the window
+	void load(const size_t bank, const std::vector<Cell>& data) {
+		checkBank(bank);
+		if (data.size() > _size)
+			throw std::out_of_range(fmt::format("Bank data ({} cells) is larger than the window", data.size()));
+		std::copy(data.begin(), data.end(), _cells.begin() + bank * _size);
+		if (bank == _bank)
+			remap();
+	}
+
+	void select(const size_t bank) {
+		checkBank(bank);
+		if (bank != _bank) {
+			_bank = bank;
+			remap();
+		}
+	}
+
+	size_t selected() const { return _bank;     }
+	size_t banks() const    { return _banks;    }
+	Address size() const    { return _size;     }
+	bool writable() const   { return _writable; }
+
+	Cell Read(const Address address) override {
+		return _cells[offset(address)];
+	}
+
+	void Write(const Address address, const Cell b) override {
+		if (_writable)
+			_cells[offset(address)] = b;
+	}
+
+	std::string type() const override {
+		return _writable ? "Banked RAM" : "Banked ROM";
+	}
+
+	// Host pointer to the cell for address in the selected bank
+	Cell* cells(const Address address) {
+		return &_cells[offset(address)];
+	}
+
+	void saveState(SnapshotWriter& snapshot) const {
+		snapshot.putTag("BANK");
+		snapshot.put<uint64_t>(_banks);
+		snapshot.put<uint64_t>(_size);
+		snapshot.put<uint64_t>(_bank);
+		snapshot.putCells<Cell>(_cells);
+	}
+
+	SnapshotRestore readState(SnapshotReader& snapshot) {
+		snapshot.expectTag("BANK");
+		const auto banks = snapshot.get<uint64_t>();
+		const auto size = snapshot.get<uint64_t>();
+		const auto bank = snapshot.get<uint64_t>();
+		if (banks != _banks || size != _size || bank >= _banks)
+			throw SnapshotReader::Exception("Banked memory doesn't match the snapshot");
+
+		std::vector<Cell> cells(_cells.size());
+		snapshot.getCells<Cell>(cells);
+		return [this, bank, cells = std::move(cells)]() mutable {
+			_cells = std::move(cells);
+			_bank = bank;
+			remap();
+		};
+	}
+
+	// Memory tells the banks where they're mapped, and how to repoint the window's pages
+	void attach(const void* owner, const Address base, const remapfn_t remap) {
+		_owner = owner;
+		_base = base;
+		_remap = remap;
+	}
+
+	void detach(const void* owner) {
+		if (_owner == owner) {
+			_owner = nullptr;
+			_remap = nullptr;
+		}
+	}
+
 private:
-	Cell _cell;
+	Address _size;
+	size_t _banks;
+	bool _writable;
+	std::vector<Cell> _cells;	// Every bank, one after another
+	size_t _bank = 0;
+	Address _base = 0;
+	const void* _owner = nullptr;
+	remapfn_t _remap;
+
+	size_t offset(const Address address) const {
+		return _bank * _size + (address - _base);
+	}
+
+	void checkBank(const size_t bank) const {
+		if (bank >= _banks)
+			throw std::out_of_range(fmt::format("Bank {} out of range, there are {} banks", bank, _banks));
+	}
+
+	void remap() {
+		if (_remap)
+			_remap(_base, static_cast<Address>(_base + _size - 1));
+	}
 };
 
 // Memory mapped devices, ie. a keyboard and terminal.  This 
@@ -151,6 +313,8 @@ private:
 	writefn_t _writefn;
 };
 
+class EventScheduler;
+
 class Device {
 public:
 	// These should be in order of precedence 
@@ -158,26 +322,32 @@ public:
 		Debug,
 		Exit,
 		Reset,
+		IRQ,
 		None
 	};
 
-	using BusSignals = std::set<Lines>;
+	// Lines asserted together, one bit per line
+	using Signals = uint32_t;
+	static constexpr Signals signal(const Lines line) { return Signals(1) << line; }
+
+	// Timed events.  startEvents() is called when the device is added to an EventScheduler, and
+	// event() when one of the events it scheduled comes due.  cycle is when the event was due.
+	virtual void startEvents([[maybe_unused]] EventScheduler& scheduler) { }
+	virtual Lines event([[maybe_unused]] EventScheduler& scheduler, [[maybe_unused]] uint64_t cycle, [[maybe_unused]] int id) { return None; }
 
-	virtual BusSignals housekeeping() { return {}; }
 	virtual void enable()       { _active = true;  }
 	virtual void disable()      { _active = false; }
+
+	// Machine snapshots.  A device with state worth keeping writes it in saveState().  readState()
+	// reads the same values back without changing the device, and returns what loads them.
+	virtual void saveState([[maybe_unused]] SnapshotWriter& snapshot) { }
+	virtual SnapshotRestore readState([[maybe_unused]] SnapshotReader& snapshot) { return [] { }; }
 	virtual bool isActive()     { return _active ; }
 	
-#if 0
-	// TODO: Fix this.
-	// When the Bus class runs these by directly calling b->setup(), make them virtual functions.
-	// Until then, just leave these ifdef'd out and let MemMappedDevice handle it.
-
-	// Run before and after emulation commences.  Use for things like setting up and 
-	// resetting terminal settings, etc. 
+	// Run by the Bus before and after emulation commences, and around debugger commands.  Use
+	// for things like setting up and resetting terminal settings, etc.
 	virtual void setup() { }
-	virtual void teardown() { };
-#endif
+	virtual void teardown() { }
 
 private:
 	bool _active = false;
@@ -223,6 +393,32 @@ protected:
 	}
 };
 
+// A register that selects the bank a BankedMemory shows, for machines that
+// switch banks with a write to an I/O port.  Writing n selects bank n modulo the
+// number of banks, and reading returns the selected bank.
+template<class Address, class Cell>
+class BankSelect : public MemMappedDevice<Address, Cell> {
+public:
+	BankSelect(std::shared_ptr<BankedMemory<Address, Cell>> banks) : _banks(banks) {
+		this->_ioPorts = { 0 };
+	}
+
+	Cell Read([[maybe_unused]] const Address address) override {
+		return static_cast<Cell>(_banks->selected());
+	}
+
+	void Write([[maybe_unused]] const Address address, const Cell b) override {
+		_banks->select(static_cast<size_t>(b) % _banks->banks());
+	}
+
+	std::string type() const override {
+		return "BankSelect";
+	}
+
+private:
+	std::shared_ptr<BankedMemory<Address, Cell>> _banks;
+};
+
 /////////
 // memory class
 template<class Address = uint64_t, class Cell = uint8_t>
@@ -290,77 +486,286 @@ public:
     }
 
     iterator end() {
-        return iterator(this, _mem.size());
+        return iterator(this, _cells.size());
     }
 
 	Memory(const Address endAddress) : _endAddress(endAddress) {
 		uint64_t _size = _endAddress + 1;
 
-		if (_size > _mem.max_size()) {
+		if (_size > _cells.max_size()) {
 			auto s = fmt::format("End address {:0{}x} exceeds host system memory limits", endAddress, AddressWidth);
 			exception(s);
 		}
 		_unmapped = std::make_shared<::Element<Address, Cell>>();
+		_ram = std::make_shared<::RAM<Address, Cell>>(_cells);
+		_rom = std::make_shared<::ROM<Address, Cell>>(_cells);
 
-		Reset();
+		_watch.assign(_size, false);
+		_cells.assign(_size, Cell(0));
+		_pages.assign((_size >> PageShift) + 1, page{ nullptr, nullptr, nullptr });
+		_codePages.assign((_size >> PageShift) + 1, false);
+		_dirty.assign((_size >> PageShift) + 1, false);
+		_observedPages.assign((_size >> PageShift) + 1, 0);
 	}
 
+	// The page table and the RAM and ROM elements point into _cells, so a copy would share the
+	// original's storage
+	Memory(const Memory&) = delete;
+	Memory& operator=(const Memory&) = delete;
+
+	~Memory() {
+		for (const auto regions : { &_regions, &_checkpointRegions }) {
+			for (const auto& [start, r] : *regions) {
+				if (auto banks = dynamic_cast<::BankedMemory<Address,Cell>*>(r.element.get()))
+					banks->detach(this);
+			}
+		}
+	}
+
+	// Put memory back the way it was at the last checkpoint(), or empty and unmapped if there
+	// hasn't been one.  Only the pages written since then are copied back, and the page table is
+	// only rebuilt if the map has changed.
 	void Reset() {
-		uint64_t _size = _endAddress + 1;
+		for (const auto start : _dirtyPages) {
+			const Address end = pageEnd(start);
+			if (_checkpointCells.empty())
+				std::fill(_cells.begin() + start, _cells.begin() + end + 1, Cell(0));
+			else
+				std::copy(_checkpointCells.begin() + start, _checkpointCells.begin() + end + 1, _cells.begin() + start);
+			codeChanged(start, end);
+		}
+		clearDirtyPages();
 
-		_mem.clear();
-		_mem.reserve(_size);
-		_watch.reserve(_size);
+		if (_watched)
+			clearAllWatches();
 
-		_mem.assign(_size, _unmapped);
-		_watch.assign(_size, false);
+		if (_mapChanged) {
+			_regions = _checkpointRegions;
+			_mapChanged = false;
+			updatePages(0, _endAddress);
+			codeChanged(0, _endAddress);
+		}
+	}
+
+	// Dirty pages and checkpoints
+	//   Every page of RAM and ROM storage changed since the last checkpoint is recorded.  The
+	//   changes can be saved as a delta and applied to another Memory at the same checkpoint, or
+	//   thrown away with Reset().  Until a page is dirty its page table entry has no write
+	//   pointer, so the first write to it takes the slow path and later writes cost nothing extra.
+
+	// Make the current contents and map the ones Reset() goes back to
+	void checkpoint() {
+		if (_checkpointCells.empty()) {
+			_checkpointCells = _cells;
+		} else {
+			for (const auto start : _dirtyPages)
+				std::copy(_cells.begin() + start, _cells.begin() + pageEnd(start) + 1, _checkpointCells.begin() + start);
+		}
+		_checkpointRegions = _regions;
+		_mapChanged = false;
+		clearDirtyPages();
+	}
+
+	// The first address of each page written since the last checkpoint, in the order they were
+	// first written
+	const std::vector<Address>& dirtyPages() const {
+		return _dirtyPages;
+	}
+
+	bool isPageDirty(const Address address) const {
+		boundsCheck(address);
+		return _dirty[address >> PageShift];
+	}
+
+	// The contents of the dirty pages.  Only contents are saved; the memory it's applied to
+	// should have the same map.
+	void saveDelta(SnapshotWriter& snapshot) {
+		snapshot.putTag("MEMD");
+		snapshot.put<uint64_t>(_endAddress);
+		snapshot.put<uint8_t>(sizeof(Cell));
+
+		snapshot.put<uint64_t>(_dirtyPages.size());
+		for (const auto start : _dirtyPages) {
+			const Address end = pageEnd(start);
+			snapshot.put<uint64_t>(start);
+			snapshot.put<uint64_t>(end);
+			snapshot.putCells<Cell>(std::span<const Cell>(_cells.begin() + start, _cells.begin() + end + 1));
+		}
+	}
+
+	void applyDelta(SnapshotReader& snapshot) {
+		snapshot.expectTag("MEMD");
+		const auto endAddress = snapshot.get<uint64_t>();
+		const auto cellSize = snapshot.get<uint8_t>();
+		if (endAddress != _endAddress || cellSize != sizeof(Cell))
+			exception("Delta is for a different size of memory");
+
+		// Read every page aside, so a delta that doesn't fit leaves memory as it was
+		std::vector<std::pair<Address, std::vector<Cell>>> contents;
+		for (auto count = snapshot.get<uint64_t>(); count; count--) {
+			const auto start = snapshot.get<uint64_t>();
+			const auto end = snapshot.get<uint64_t>();
+			if (end < start || end > _endAddress || (start >> PageShift) != (end >> PageShift))
+				exception("Delta page is invalid");
+			contents.emplace_back(static_cast<Address>(start), std::vector<Cell>(end - start + 1));
+			snapshot.getCells<Cell>(contents.back().second);
+		}
+
+		for (const auto& [start, cells] : contents) {
+			std::copy(cells.begin(), cells.end(), _cells.begin() + start);
+			markDirty(start >> PageShift);
+			codeChanged(start, static_cast<Address>(start + cells.size() - 1));
+		}
 	}
 
 	size_t size() {
-		return _mem.size();
+		return _cells.size();
 	}
 
 	std::vector<Address> find(std::string sequence, Cell filter = -1 ) {
 		std::vector<Address> positions;
+		for (const auto& m : search(MemorySearch<Cell>({ MemorySearch<Cell>::fromString(sequence) }, filter)))
+			positions.push_back(static_cast<Address>(m.offset));
 
-        if(sequence.size() > _mem.size())
-            return positions; 
-        
-       for (size_t i = 0; i <= _mem.size() - sequence.size(); ++i) {
-            bool matches = true;
-            for (size_t j = 0; j < sequence.size(); ++j) {
-				Address a = static_cast<Address>(i + j);
-                if (sequence[j] != (_mem[a]->Read(a) & filter)) {
-                    matches = false;
-                    break;
-                }
-            }
-            if (matches) {
-                positions.push_back(static_cast<Address>(i));
-            }
-        }
-
-        return positions;
+		return positions;
+	}
+
+	// Every match of searcher in memory, at its address.  Memory is looked at with Peek(), so a
+	// search changes nothing, and devices are left out: matches are only found in the runs of
+	// memory between them.
+	std::vector<typename MemorySearch<Cell>::match> search(const MemorySearch<Cell>& searcher) {
+		std::vector<typename MemorySearch<Cell>::match> matches;
+		std::vector<Cell> cells;
+
+		auto scan = [&](const uint64_t start, const uint64_t end) {
+			cells.resize(end - start + 1);
+			peekBlock(static_cast<Address>(start), cells);
+			for (const auto& m : searcher.search(cells))
+				matches.push_back({ start + m.offset, m.patternIndex });
+		};
+
+		uint64_t next = 0;
+		for (const auto& [start, r] : _regions) {
+			if (regionKind(r.element.get()) != DeviceRegion)
+				continue;
+			if (start > next)
+				scan(next, uint64_t(start) - 1);
+			next = uint64_t(r.end) + 1;
+		}
+		if (next <= _endAddress)
+			scan(next, _endAddress);
+
+		return matches;
 	}
 
 	Cell Read(const Address address) {
 		boundsCheck(address);
-		return _mem.at(address)->Read(address);
+		const page& p = _pages[address >> PageShift];
+		if (p.read)
+			return p.read[address & PageMask];
+		return observedRead(address, Observer::Read);
+	}
+
+	// Read an instruction byte.  The same as Read() except for what observers see.
+	Cell Fetch(const Address address) {
+		boundsCheck(address);
+		const page& p = _pages[address >> PageShift];
+		if (p.read)
+			return p.read[address & PageMask];
+		return observedRead(address, Observer::Fetch);
+	}
+
+	// Look at a cell without reading it.  Observers aren't told, and devices, where a read can
+	// have side effects, aren't read at all; they look like 0.
+	Cell Peek(const Address address) {
+		boundsCheck(address);
+		const page& p = _pages[address >> PageShift];
+		if (p.read)
+			return p.read[address & PageMask];
+		if (isDevice(address))
+			return 0;
+		return elementAt(address)->Read(address);
 	}
 
 	void Write(const Address address, const Cell l) {
 		boundsCheck(address);
-		if (_watch[address]) {
-			fmt::print("mem[{:0{}x}] {:0{}x} -> {:0{}x}\n", address, AddressWidth, _mem.at(address)->Read(address), CellWidth, l, CellWidth);
+		const page& p = _pages[address >> PageShift];
+		if (p.write) {
+			p.write[address & PageMask] = l;
+		} else if (p.ram) {
+			markDirty(address >> PageShift);
+			p.write[address & PageMask] = l;
+		} else {
+			auto element = elementAt(address);
+			element->Write(address, l);
+			if (element == _ram.get())
+				markDirty(address >> PageShift);
+			if (_observedPages[address >> PageShift] & Observer::Write)
+				notifyObservers(address, l, Observer::Write);
 		}
-
-		_mem.at(address)->Write(address, l);
+		codeChanged(address);
 	}
 
 	void assign(const Address a1, const Address a2, const Cell value) {
-			for (uint32_t a = a1; a <= a2; a++) {
-				_mem.at(a)->Write(a, value);
-			}
+		fill(a1, a2, value);
+	}
+
+	// Block operations
+	//   Runs of cells in pages that are all RAM or ROM are copied or filled directly.  Cells in
+	//   any other page go through Read() and Write() one at a time.
+
+	void readBlock(const Address start, const std::span<Cell> out) {
+		forEachRun(start, out.size(), false,
+			[&](const page& p, const Address offset, const size_t i, const size_t length) {
+				std::copy_n(p.read + offset, length, out.begin() + i);
+			},
+			[&](const Address address, const size_t i) {
+				out[i] = Read(address);
+			});
+	}
+
+	std::vector<Cell> readBlock(const Address start, const Address end) {
+		std::vector<Cell> out(end < start ? 0 : uint64_t(end) - start + 1);
+		readBlock(start, out);
+		return out;
+	}
+
+	// The same as readBlock(), but through Peek()
+	void peekBlock(const Address start, const std::span<Cell> out) {
+		forEachRun(start, out.size(), false,
+			[&](const page& p, const Address offset, const size_t i, const size_t length) {
+				std::copy_n(p.read + offset, length, out.begin() + i);
+			},
+			[&](const Address address, const size_t i) {
+				out[i] = Peek(address);
+			});
+	}
+
+	void writeBlock(const Address start, const std::span<const Cell> data) {
+		forEachRun(start, data.size(), true,
+			[&](const page& p, const Address offset, const size_t i, const size_t length) {
+				std::copy_n(data.begin() + i, length, p.write + offset);
+			},
+			[&](const Address address, const size_t i) {
+				Write(address, data[i]);
+			});
+	}
+
+	void fill(const Address start, const Address end, const Cell value) {
+		if (end < start)
+			return;
+		forEachRun(start, uint64_t(end) - start + 1, true,
+			[&](const page& p, const Address offset, [[maybe_unused]] const size_t i, const size_t length) {
+				std::fill_n(p.write + offset, length, value);
+			},
+			[&](const Address address, [[maybe_unused]] const size_t i) {
+				Write(address, value);
+			});
+	}
+
+	// Copy start:end to destination.  The ranges may overlap.
+	void copy(const Address start, const Address end, const Address destination) {
+		writeBlock(destination, readBlock(start, end));
 	}
 
 	MemoryProxy operator[](Address address) {
@@ -375,11 +780,9 @@ public:
 			return false;
 		}
 
-		auto startIdx = _mem.begin() + start;
-		auto endIdx   = _mem.begin() + end;
-		for (auto it = startIdx; it <= endIdx; it++) {
-			(*it) = std::make_shared<::RAM<Address,Cell>>();
-		}
+		zeroCells(start, end);
+		mapRegion(start, end, _ram);
+		codeChanged(start, end);
 
 		return true;
 	}
@@ -401,13 +804,14 @@ public:
 			exception(s);
 		}
 
-		auto startIdx = _mem.begin() + start;
-		auto endIdx   = startIdx + rom.size();
-		uint64_t i = 0;
+		if (rom.empty())
+			return true;
 
-		for (auto it = startIdx; it != endIdx && it != _mem.end(); it++, i++) {
-			(*it) = std::make_shared<::ROM<Address,Cell>>(rom[i]);
-		}
+		const Address end = static_cast<Address>(start + rom.size() - 1);
+		std::copy(rom.begin(), rom.end(), _cells.begin() + start);
+		markDirty(start, end);
+		mapRegion(start, end, _rom);
+		codeChanged(start, end);
 
 		return true;
 	}
@@ -429,7 +833,8 @@ public:
 			return false;
 		}
 
-		_mem[address] = std::make_shared<::MIO<Address,Cell>>(readfn, writefn);
+		mapRegion(address, address, std::make_shared<::MIO<Address,Cell>>(readfn, writefn));
+		codeChanged(address);
 		return true;
 	}
 
@@ -443,21 +848,43 @@ public:
 				exception(s);
 				return false;
 			}
-			_mem[addr] = device;
+			mapRegion(addr, addr, device);
+			codeChanged(addr);
 		}
 		return true;
 	}
 
-	bool isAddressMapped(const Address address) const {
-		return isAddressMapped(_mem[address]);
+	// Map the window of banks at start
+	bool mapBanks(std::shared_ptr<::BankedMemory<Address,Cell>> banks, const Address start, const bool overwriteExistingElements = true) {
+		const uint64_t end = uint64_t(start) + banks->size() - 1;
+		if (banks->size() == 0 || end > _endAddress) {
+			auto s = fmt::format("Banks will not fit into memory at start address {:0{}x} (window {} cells)", start, AddressWidth, banks->size());
+			exception(s);
+		}
+		if (!overwriteExistingElements && addressRangeOverlapsExistingMap(start, static_cast<Address>(end))) {
+			auto s = fmt::format("Address range {:0{}x}:{:0{}x} overlaps with existing map", start, AddressWidth, end, AddressWidth);
+			exception(s);
+			return false;
+		}
+
+		banks->attach(this, start, [this](const Address first, const Address last) {
+			updatePages(first, last);
+			codeChanged(first, last);
+		});
+		mapRegion(start, static_cast<Address>(end), banks);
+		codeChanged(start, static_cast<Address>(end));
+		return true;
 	}
 
-	bool isAddressMapped(const std::shared_ptr<Element<Address,Cell>> e) const {
-		return e != _unmapped;
+	void unmap(const Address start, const Address end) {
+		boundsCheck(end);
+		unmapRegion(start, end);
+		updatePages(start, end);
+		codeChanged(start, end);
 	}
 
-	bool addressUnmapped(const std::shared_ptr<Element<Address,Cell>> e) const {
-		return e == _unmapped;
+	bool isAddressMapped(const Address address) const {
+		return elementAt(address) != _unmapped.get();
 	}
 
 	void hexdump(const Address start, Address end, std::string valueExpression = "") {
@@ -482,18 +909,16 @@ public:
 		int cnt = 0;
 		std::string hexdump, ascii;
         
-		auto begin = _mem.begin() + start;
-		auto stop = _mem.begin() + end; 
-		for (auto it = begin; it <= stop; it++) {
+		const auto cells = readBlock(start, end);
+		for (uint64_t a = start; a <= end; a++) {
+			const Address address = static_cast<Address>(a);
 
 			// Start a new line with the memory address
 			if (cnt == 0) {
-				auto addr = std::distance(_mem.begin(), it);
-				hexdump += fmt::format("{:0>{}x}  ", addr, AddressWidth);
+				hexdump += fmt::format("{:0>{}x}  ", address, AddressWidth);
 			}
 			Cell c;
-			Address address = static_cast<Address>(std::distance(_mem.begin(), it));
-			c = (*it)->Read(address);
+			c = cells[a - start];
 
 			c = calculateValue(valueExpression, c);
 
@@ -510,7 +935,7 @@ public:
 			
 			// Print the accumulated line if we're at the end of the line or the end of the memory range.
 			cnt++;
-			if (cnt == lineEnd || it == stop) {
+			if (cnt == lineEnd || address == end) {
 				cnt = 0;
 				hexdump = fmt::format("{:{}}", hexdump, hexwidth);
 				fmt::print("{}{}\n", hexdump, ascii);
@@ -521,33 +946,36 @@ public:
 	}
 
 	void printMap() const {
-		auto it = _mem.begin();
-		auto range_start = it;
 		uint64_t mappedBytes = 0;
 		std::map<std::string, uint64_t> sizeByType;
+		std::vector<std::tuple<uint64_t, uint64_t, std::string>> ranges;
+
+		// Neighbouring regions of the same type print as one range, as do gaps between regions
+		auto addRange = [&](const uint64_t start, const uint64_t end, const std::string type) {
+			if (!ranges.empty() && std::get<2>(ranges.back()) == type)
+				std::get<1>(ranges.back()) = end;
+			else
+				ranges.emplace_back(start, end, type);
+		};
 
-		fmt::print("Memory map:\n");
-
-		while (it != _mem.end()) {
-			if (!addressUnmapped(*it))
-				mappedBytes++;
-
-			auto next_it = std::next(it);
-			bool endOfRange = (next_it == _mem.end()) || ((*next_it)->type() != (*range_start)->type());
-			
-			if (endOfRange) {
-				Address bytes = 1 + static_cast<Address>(std::distance(range_start, it));
-				Address start = static_cast<Address>(std::distance(_mem.begin(), range_start));
-				Address end = static_cast<Address>(std::distance(_mem.begin(), it));
-				auto type = (*it)->type();
-				sizeByType[type] += bytes;
+		uint64_t next = 0;
+		for (const auto& [start, r] : _regions) {
+			if (start > next)
+				addRange(next, start - 1, _unmapped->type());
+			addRange(start, r.end, r.element->type());
+			mappedBytes += r.end - start + 1;
+			next = uint64_t(r.end) + 1;
+		}
+		if (next <= _endAddress)
+			addRange(next, _endAddress, _unmapped->type());
 
-				fmt::print("{:0{}x} - {:0{}x} {:<9} {:>5} bytes\n", start, AddressWidth, end, AddressWidth, type, bytes);
+		fmt::print("Memory map:\n");
 
-				range_start = next_it;
-			}
+		for (const auto& [start, end, type] : ranges) {
+			uint64_t bytes = end - start + 1;
+			sizeByType[type] += bytes;
 
-			it = next_it;
+			fmt::print("{:0{}x} - {:0{}x} {:<9} {:>5} bytes\n", start, AddressWidth, end, AddressWidth, type, bytes);
 		}
 		
 		fmt::print("Total bytes mapped:   {} bytes\n", mappedBytes * sizeof(Cell));
@@ -562,43 +990,228 @@ public:
 	// Loading data into memory
 
 	void loadDataFromFile(const char *filename, Address start) {
-		auto vec = _loadDataFromFile(filename);
-		loadData(vec, start);
+		auto file = _mapFile(filename);
+		_loadData(file.cells.get(), file.size, start);
 	}
 
 	void loadDataFromFile(std::string& filename, Address start) {
 		loadDataFromFile(filename.c_str(), start);
 	}
 
+	// The ROM is read straight from the file's pages rather than copied into memory
 	void loadRomFromFile(const char *filename, Address start) {
-		auto vec = _loadDataFromFile(filename); 
-		mapROM(start, vec);
+		auto file = _mapFile(filename); 
+		if (file.size == 0)
+			return;
+
+		if (start + file.size - 1 > _endAddress) {
+			auto s = fmt::format("ROM will not fit into memory at start address {:0{}x} (data length {} bytes)",
+					     start, AddressWidth, file.size);
+			exception(s);
+		}
+
+		const Address end = static_cast<Address>(start + file.size - 1);
+		mapRegion(start, end, std::make_shared<::MappedROM<Address,Cell>>(file.cells, start));
+		codeChanged(start, end);
 	}
 
 	void loadData(const std::vector<Cell> &data, const Address startAddress) {
-		if (startAddress > _endAddress) {
-			auto s = fmt::format("Data load address is not a valid address: {:0{}x}", startAddress, AddressWidth);
-			exception(s);
+		_loadData(data.data(), data.size(), startAddress);
+	}
+
+	// True for addresses backed by MIO or a MemMappedDevice, where a read can have side effects
+	bool isDevice(const Address address) {
+		boundsCheck(address);
+		auto element = elementAt(address);
+		return dynamic_cast<::MIO<Address,Cell>*>(element) != nullptr || dynamic_cast<Device*>(element) != nullptr;
+	}
+
+	// Snapshots
+	//   A snapshot holds the memory map, the contents of RAM and ROM, and the state of each mapped
+	//   device and set of banks.  MIO, devices and banks can't be recreated from a snapshot, so
+	//   restoring one needs the same ones mapped at the same addresses; everything else is replaced
+	//   by what was saved.
+
+	void saveState(SnapshotWriter& snapshot) {
+		snapshot.putTag("MEM ");
+		snapshot.put<uint64_t>(_endAddress);
+		snapshot.put<uint8_t>(sizeof(Cell));
+
+		snapshot.put<uint64_t>(_regions.size());
+		for (const auto& [start, r] : _regions) {
+			const uint8_t kind = regionKind(r.element.get());
+			snapshot.put<uint64_t>(start);
+			snapshot.put<uint64_t>(r.end);
+			snapshot.put<uint8_t>(kind);
+			if (kind == RAMRegion || kind == ROMRegion)
+				snapshot.putCells<Cell>(readBlock(start, r.end));
 		}
-		if (startAddress + data.size() - 1 > _endAddress) {
-			auto s = fmt::format("Data will not fit into memory at start address {:0{}x} (data length {} bytes)",
-								  startAddress, AddressWidth, data.size());
-			exception(s);
+
+		const auto devices = mappedElements<Device>(_regions);
+		const auto banks = mappedElements<::BankedMemory<Address,Cell>>(_regions);
+		snapshot.put<uint32_t>(devices.size());
+		snapshot.put<uint32_t>(banks.size());
+		for (auto device : devices)
+			device->saveState(snapshot);
+		for (auto b : banks)
+			b->saveState(snapshot);
+	}
+
+	// Reads memory, its devices and banks aside.  Nothing changes until the returned restore runs.
+	SnapshotRestore readState(SnapshotReader& snapshot) {
+		snapshot.expectTag("MEM ");
+		const auto endAddress = snapshot.get<uint64_t>();
+		const auto cellSize = snapshot.get<uint8_t>();
+		if (endAddress != _endAddress || cellSize != sizeof(Cell))
+			exception("Snapshot is for a different size of memory");
+
+		// Build the new map and read RAM and ROM aside
+		std::map<Address, region> regions;
+		std::vector<std::pair<Address, std::vector<Cell>>> contents;
+		for (auto count = snapshot.get<uint64_t>(); count; count--) {
+			const auto start = static_cast<Address>(snapshot.get<uint64_t>());
+			const auto end = static_cast<Address>(snapshot.get<uint64_t>());
+			const auto kind = snapshot.get<uint8_t>();
+			if (end < start || end > _endAddress || kind > BankRegion)
+				exception("Snapshot memory map is invalid");
+
+			if (kind == DeviceRegion || kind == BankRegion) {
+				auto it = _regions.upper_bound(start);
+				if (it == _regions.begin() || (--it)->second.end < end || regionKind(it->second.element.get()) != kind) {
+					auto s = fmt::format("No {} mapped at {:0{}x}:{:0{}x} to restore", kind == BankRegion ? "banks" : "device",
+						start, AddressWidth, end, AddressWidth);
+					exception(s);
+				}
+				regions.emplace(start, region{ end, it->second.element });
+			} else {
+				regions.emplace(start, region{ end, kind == RAMRegion ? _ram : _rom });
+				contents.emplace_back(start, std::vector<Cell>(uint64_t(end) - start + 1));
+				snapshot.getCells<Cell>(contents.back().second);
+			}
+		}
+
+		const auto devices = mappedElements<Device>(regions);
+		if (snapshot.get<uint32_t>() != devices.size())
+			exception("Snapshot devices don't match the mapped devices");
+		const auto banks = mappedElements<::BankedMemory<Address,Cell>>(regions);
+		if (snapshot.get<uint32_t>() != banks.size())
+			exception("Snapshot banks don't match the mapped banks");
+
+		std::vector<SnapshotRestore> restores;
+		for (auto device : devices)
+			restores.push_back(device->readState(snapshot));
+		for (auto b : banks)
+			restores.push_back(b->readState(snapshot));
+
+		return [this, regions = std::move(regions), contents = std::move(contents), restores = std::move(restores)]() mutable {
+			_regions = std::move(regions);
+			_mapChanged = true;
+			for (const auto& [start, cells] : contents) {
+				std::copy(cells.begin(), cells.end(), _cells.begin() + start);
+				markDirty(start, static_cast<Address>(start + cells.size() - 1));
+			}
+			updatePages(0, _endAddress);
+			codeChanged(0, _endAddress);
+
+			for (auto& restore : restores)
+				restore();
+		};
+	}
+
+	void restoreState(SnapshotReader& snapshot) {
+		readState(snapshot)();
+	}
+
+	// Code tracking
+	//   A CPU that caches decoded instructions marks the pages it decodes from.  Any write, load
+	//   or remapping of an address in a marked page is passed to the callback so the CPU can drop
+	//   decodes that are now stale.
+	using codechangedfn_t = std::function<void(Address)>;
+
+	void setCodeChangedCallback(const codechangedfn_t fn) {
+		_codeChangedFn = fn;
+	}
+
+	void markCodePage(const Address address) {
+		boundsCheck(address);
+		_codePages[address >> PageShift] = true;
+	}
+
+	// Observers
+	//   A page observed for reads or fetches has no read pointer in the page table, and a page
+	//   observed for writes has no write pointer, so only accesses an observer might want leave
+	//   the fast path.  The same observer can be attached to any number of ranges.
+	using Observer = MemoryObserver<Address,Cell>;
+
+	void attachObserver(const std::shared_ptr<Observer> observer, const Address start, const Address end, const uint8_t accesses) {
+		boundsCheck(end);
+		if (end < start)
+			return;
+
+		auto it = findObserver(observer);
+		if (it == _observers.end()) {
+			_observers.push_back({ observer, {}, {} });
+			it = std::prev(_observers.end());
 		}
+		it->ranges.push_back({ start, end, accesses });
+		observersChanged(start, end, accesses);
+	}
+
+	// Remove the ranges observer was attached to that lie within start:end
+	void detachObserver(const std::shared_ptr<Observer>& observer, const Address start, const Address end) {
+		boundsCheck(end);
+		auto it = findObserver(observer);
+		if (it == _observers.end())
+			return;
+
+		deliver(*it);
+		uint8_t accesses = 0;
+		std::erase_if(it->ranges, [&](const observedRange& r) {
+			const bool within = r.start >= start && r.end <= end;
+			if (within)
+				accesses |= r.accesses;
+			return within;
+		});
+		if (it->ranges.empty())
+			_observers.erase(it);
+		observersChanged(start, end, accesses);
+	}
+
+	void detachObserver(const std::shared_ptr<Observer>& observer) {
+		detachObserver(observer, 0, _endAddress);
+	}
+
+	bool isObserved(const Address address, const uint8_t accesses) const {
+		boundsCheck(address);
+		if (!(_observedPages[address >> PageShift] & accesses))
+			return false;
 
-		auto a = _mem.begin() + startAddress;
-		Address addr = startAddress;
-		for (auto i = data.begin(); i != data.end(); a++, i++, addr++)  {
-			(*a)->Write(addr, *i);
+		for (const auto& o : _observers) {
+			for (const auto& r : o.ranges) {
+				if ((r.accesses & accesses) && r.start <= address && address <= r.end)
+					return true;
+			}
 		}
+		return false;
+	}
+
+	// Deliver every event that hasn't been yet
+	void flushObservers() {
+		for (auto& o : _observers)
+			deliver(o);
 	}
 
 	// watch memory address
+	//   Watches are an observer of writes that prints them
 
 	void enableWatch(const Address address) {
 		boundsCheck(address);
 		
-		_watch[address] = true;
+		if (!_watch[address]) {
+			_watch[address] = true;
+			_watched++;
+			attachObserver(_watchPrinter, address, address, Observer::Write);
+		}
 	}
 
 	bool watching(const Address address) const {
@@ -624,11 +1237,17 @@ public:
 
 	void clearWatch(Address address) {
 		boundsCheck(address);
-		_watch[address] = false;
+		if (_watch[address]) {
+			_watch[address] = false;
+			_watched--;
+			detachObserver(_watchPrinter, address, address);
+		}
 	}
 
 	void clearAllWatches() {
-		_watch.clear();
+		_watch.assign(_watch.size(), false);
+		_watched = 0;
+		detachObserver(_watchPrinter);
 	}
 
 	class Exception : public std::exception {
@@ -650,11 +1269,311 @@ private:
 
 	Address _endAddress; // Last address
 	std::shared_ptr<Element<Address,Cell>> _unmapped;	   // Default memory element 
+	std::shared_ptr<Element<Address,Cell>> _ram;		   // Shared by every RAM region
+	std::shared_ptr<Element<Address,Cell>> _rom;		   // Shared by every ROM region
+
+	// Mapped regions, keyed by their first address.  Addresses outside every region are unmapped.
+	struct region {
+		Address end;	// Last address in the region
+		std::shared_ptr<Element<Address,Cell>> element;
+	};
 
-	std::vector<std::shared_ptr<Element<Address,Cell>>> _mem;
+	std::map<Address, region> _regions;
 	std::vector<bool> _watch; // Vector of watched addresses.
+	size_t _watched = 0;      // How many of them are set
+
+	// How saveState() records each region
+	static constexpr uint8_t RAMRegion    = 0;
+	static constexpr uint8_t ROMRegion    = 1;
+	static constexpr uint8_t DeviceRegion = 2;	// MIO or a MemMappedDevice
+	static constexpr uint8_t BankRegion   = 3;
+
+	uint8_t regionKind(Element<Address,Cell>* element) const {
+		if (element == _ram.get())
+			return RAMRegion;
+		if (element == _rom.get() || dynamic_cast<::MappedROM<Address,Cell>*>(element))
+			return ROMRegion;
+		if (dynamic_cast<::BankedMemory<Address,Cell>*>(element))
+			return BankRegion;
+		return DeviceRegion;
+	}
+
+	// Each element of type T mapped in regions, once, in address order
+	template<class T>
+	std::vector<T*> mappedElements(const std::map<Address, region>& regions) const {
+		std::vector<T*> elements;
+		for (const auto& [start, r] : regions) {
+			auto element = dynamic_cast<T*>(r.element.get());
+			if (element && std::find(elements.begin(), elements.end(), element) == elements.end())
+				elements.push_back(element);
+		}
+		return elements;
+	}
+
+	Element<Address,Cell>* elementAt(const Address address) const {
+		auto it = _regions.upper_bound(address);
+		if (it == _regions.begin())
+			return _unmapped.get();
+		--it;
+		return address <= it->second.end ? it->second.element.get() : _unmapped.get();
+	}
+
+	// Map start:end to element, replacing whatever was there and merging with neighbours that
+	// share the element
+	void mapRegion(const Address start, const Address end, const std::shared_ptr<Element<Address,Cell>> element) {
+		unmapRegion(start, end);
+		_mapChanged = true;
+
+		auto it = _regions.emplace(start, region{ end, element }).first;
+		if (it != _regions.begin()) {
+			auto prev = std::prev(it);
+			if (prev->second.element == element && uint64_t(prev->second.end) + 1 == start) {
+				prev->second.end = end;
+				_regions.erase(it);
+				it = prev;
+			}
+		}
+
+		auto next = std::next(it);
+		if (next != _regions.end() && next->second.element == element && uint64_t(it->second.end) + 1 == next->first) {
+			it->second.end = next->second.end;
+			_regions.erase(next);
+		}
+
+		updatePages(start, end);
+	}
+
+	// Remove start:end from the map, trimming or splitting regions that overlap it
+	void unmapRegion(const Address start, const Address end) {
+		_mapChanged = true;
+		auto it = _regions.lower_bound(start);
+		if (it != _regions.begin()) {
+			auto prev = std::prev(it);
+			if (prev->second.end >= start) {
+				if (prev->second.end > end)
+					_regions.emplace(static_cast<Address>(end + 1), prev->second);
+				prev->second.end = static_cast<Address>(start - 1);
+			}
+		}
 
-	void boundsCheck(const Address address) {
+		it = _regions.lower_bound(start);
+		while (it != _regions.end() && it->first <= end) {
+			if (it->second.end > end) {
+				region r = it->second;
+				_regions.erase(it);
+				_regions.emplace(static_cast<Address>(end + 1), r);
+				break;
+			}
+			it = _regions.erase(it);
+		}
+	}
+
+	// Page table.  A page holding only RAM and ROM, none of it observed, reads straight from
+	// _cells; if it's all RAM it's written there too once it's dirty.  A page that lies entirely
+	// within a mapped ROM image reads straight from the image, and one within a window of banks
+	// reads, and for RAM writes, the selected bank.  Everything else goes to the elements.
+	static constexpr int PageShift = 8;
+	static constexpr Address PageMask = (Address(1) << PageShift) - 1;
+
+	struct page {
+		const Cell* read;
+		Cell* write;	// For RAM in _cells, only set once the page is dirty
+		Cell* ram;		// Set if the page is all RAM in _cells
+	};
+
+	std::vector<Cell> _cells;	// Storage for RAM and ROM
+	std::vector<page> _pages;
+
+	void updatePages(const Address start, const Address end) {
+		for (uint64_t p = start >> PageShift; p <= uint64_t(end >> PageShift); p++) {
+			const uint64_t first = p << PageShift;
+			const uint64_t last = std::min<uint64_t>(first + PageMask, _endAddress);
+			const Cell* read = &_cells[first];
+			Cell* write = &_cells[first];
+			bool tracked = true;	// Whether write points into _cells
+
+			for (uint64_t a = first; a <= last && read; ) {
+				auto it = _regions.upper_bound(static_cast<Address>(a));
+				if (it == _regions.begin() || (--it)->second.end < a) {
+					read = write = nullptr;
+					break;
+				}
+				const auto& element = it->second.element;
+				auto image = dynamic_cast<::MappedROM<Address,Cell>*>(element.get());
+				auto banks = dynamic_cast<::BankedMemory<Address,Cell>*>(element.get());
+				if (element == _rom) {
+					write = nullptr;
+				} else if (image && it->first <= first && it->second.end >= last) {
+					read = image->cells(static_cast<Address>(first));
+					write = nullptr;
+				} else if (banks && it->first <= first && it->second.end >= last) {
+					read = write = banks->cells(static_cast<Address>(first));
+					if (!banks->writable())
+						write = nullptr;
+					tracked = false;
+				} else if (element != _ram) {
+					read = write = nullptr;
+				}
+				a = uint64_t(it->second.end) + 1;
+			}
+
+			if (_observedPages[p] & (Observer::Read | Observer::Fetch))
+				read = nullptr;
+			if (_observedPages[p] & Observer::Write)
+				write = nullptr;
+
+			if (tracked)
+				_pages[p] = { read, _dirty[p] ? write : nullptr, write };
+			else
+				_pages[p] = { read, write, nullptr };
+		}
+	}
+
+	// Observers and the ranges each is attached to, with the events it hasn't been given yet
+	struct observedRange {
+		Address start;
+		Address end;
+		uint8_t accesses;
+	};
+
+	struct observerEntry {
+		std::shared_ptr<Observer> observer;
+		std::vector<observedRange> ranges;
+		std::vector<typename Observer::event> events;
+	};
+
+	static constexpr size_t ObserverBatch = 256;	// Events delivered at a time
+
+	std::vector<observerEntry> _observers;
+	std::vector<uint8_t> _observedPages;	// The accesses observed anywhere in each page
+
+	auto findObserver(const std::shared_ptr<Observer>& observer) {
+		return std::find_if(_observers.begin(), _observers.end(), [&](const observerEntry& o) { return o.observer == observer; });
+	}
+
+	// Only fetch observers change what the CPU may cache, so only they count as a code change
+	void observersChanged(const Address start, const Address end, const uint8_t changed) {
+		for (uint64_t p = start >> PageShift; p <= uint64_t(end >> PageShift); p++) {
+			const uint64_t first = p << PageShift;
+			const uint64_t last = first + PageMask;
+			uint8_t accesses = 0;
+			for (const auto& o : _observers) {
+				for (const auto& r : o.ranges) {
+					if (r.start <= last && r.end >= first)
+						accesses |= r.accesses;
+				}
+			}
+			_observedPages[p] = accesses;
+		}
+		updatePages(start, end);
+		if (changed & Observer::Fetch)
+			codeChanged(start, end);
+	}
+
+	Cell observedRead(const Address address, const typename Observer::Access access) {
+		const Cell value = elementAt(address)->Read(address);
+		if (_observedPages[address >> PageShift] & access)
+			notifyObservers(address, value, access);
+		return value;
+	}
+
+	void notifyObservers(const Address address, const Cell value, const typename Observer::Access access) {
+		for (auto& o : _observers) {
+			for (const auto& r : o.ranges) {
+				if ((r.accesses & access) && r.start <= address && address <= r.end) {
+					o.events.push_back({ address, value, access });
+					if (o.events.size() == ObserverBatch)
+						deliver(o);
+					break;
+				}
+			}
+		}
+	}
+
+	void deliver(observerEntry& o) {
+		if (o.events.empty())
+			return;
+		o.observer->observe(o.events);
+		o.events.clear();
+	}
+
+	class WatchPrinter : public Observer {
+	public:
+		void observe(const std::span<const typename Observer::event> events) override {
+			for (const auto& e : events)
+				fmt::print("mem[{:0{}x}] <- {:0{}x}\n", e.address, AddressWidth, e.value, CellWidth);
+		}
+	};
+
+	std::shared_ptr<WatchPrinter> _watchPrinter = std::make_shared<WatchPrinter>();
+
+	// Dirty tracking.  A page that isn't dirty holds the same cells as at the last checkpoint.
+	std::vector<bool> _dirty;
+	std::vector<Address> _dirtyPages;
+	std::vector<Cell> _checkpointCells;		// Empty until the first checkpoint, when all cells are 0
+	std::map<Address, region> _checkpointRegions;
+	bool _mapChanged = false;				// Since the last checkpoint
+
+	Address pageEnd(const Address start) const {
+		return static_cast<Address>(std::min<uint64_t>(uint64_t(start) | PageMask, _endAddress));
+	}
+
+	void markDirty(const uint64_t p) {
+		if (_dirty[p])
+			return;
+		_dirty[p] = true;
+		_dirtyPages.push_back(static_cast<Address>(p << PageShift));
+		_pages[p].write = _pages[p].ram;
+	}
+
+	void markDirty(const Address start, const Address end) {
+		for (uint64_t p = start >> PageShift; p <= uint64_t(end >> PageShift); p++)
+			markDirty(p);
+	}
+
+	void clearDirtyPages() {
+		for (const auto start : _dirtyPages) {
+			auto& p = _pages[start >> PageShift];
+			_dirty[start >> PageShift] = false;
+			if (p.ram)
+				p.write = nullptr;
+		}
+		_dirtyPages.clear();
+	}
+
+	// Zero start:end.  A clean page is already 0 until there's a checkpoint, so it's skipped.
+	void zeroCells(const Address start, const Address end) {
+		for (uint64_t p = start >> PageShift; p <= uint64_t(end >> PageShift); p++) {
+			if (!_dirty[p] && _checkpointCells.empty())
+				continue;
+			const uint64_t first = std::max<uint64_t>(p << PageShift, start);
+			const uint64_t last = std::min<uint64_t>(((p + 1) << PageShift) - 1, end);
+			std::fill(_cells.begin() + first, _cells.begin() + last + 1, Cell(0));
+			markDirty(p);
+		}
+	}
+
+	// Pages marked by markCodePage()
+	std::vector<bool> _codePages;
+	codechangedfn_t _codeChangedFn;
+
+	void codeChanged(const Address address) {
+		if (_codePages[address >> PageShift] && _codeChangedFn)
+			_codeChangedFn(address);
+	}
+
+	void codeChanged(const Address start, const Address end) {
+		if (!_codeChangedFn)
+			return;
+		for (uint64_t a = start; a <= end; a++) {
+			if (_codePages[a >> PageShift])
+				_codeChangedFn(static_cast<Address>(a));
+			else
+				a |= PageMask;	// Skip the rest of an unmarked page
+		}
+	}
+
+	void boundsCheck(const Address address) const {
 		if (!boundsCheckNoThrow(address)) {
 			auto s = fmt::format("Address {:0{}x} out of range", address, AddressWidth);
 			exception(s);
@@ -665,14 +1584,12 @@ private:
 		return (address <= _endAddress);
 	}
 
-	bool addressRangeOverlapsExistingMap(const Address start, const Address end) {
-		auto startIdx = _mem.begin() + start;
-		auto endIdx   = _mem.begin() + end;
-		for (auto it = startIdx; it <= endIdx; it++) {
-			if (isAddressMapped((*it)))
-				return true;
-		}
-		return false;
+	bool addressRangeOverlapsExistingMap(const Address start, const Address end) const {
+		// Only the last region starting at or before end can reach back to start
+		auto it = _regions.upper_bound(end);
+		if (it == _regions.begin())
+			return false;
+		return (--it)->second.end >= start;
 	}
 
 	Cell calculateValue(const std::string& expression, Cell initialValue) {
@@ -732,6 +1649,96 @@ private:
 		return values.front();
 	}
 
+	// Copy size cells into memory at startAddress, straight into pages that are all RAM
+	void _loadData(const Cell* data, const size_t size, const Address startAddress) {
+		if (startAddress > _endAddress) {
+			auto s = fmt::format("Data load address is not a valid address: {:0{}x}", startAddress, AddressWidth);
+			exception(s);
+		}
+		if (startAddress + size - 1 > _endAddress) {
+			auto s = fmt::format("Data will not fit into memory at start address {:0{}x} (data length {} bytes)",
+								  startAddress, AddressWidth, size);
+			exception(s);
+		}
+
+		writeBlock(startAddress, std::span<const Cell>(data, size));
+	}
+
+	// Break count cells from start into runs that stay within a page.  fast(page, offset in
+	// page, index, length) is called for a run in a page with a host pointer for the access,
+	// slow(address, index) for each cell in any other page.
+	template<class FastFn, class SlowFn>
+	void forEachRun(const Address start, const size_t count, const bool writing, FastFn fast, SlowFn slow) {
+		if (count == 0)
+			return;
+		if (uint64_t(start) + count - 1 > _endAddress) {
+			auto s = fmt::format("Address range {:0{}x}:{:0{}x} out of range", start, AddressWidth, uint64_t(start) + count - 1, AddressWidth);
+			exception(s);
+		}
+
+		const uint64_t end = uint64_t(start) + count;
+		for (uint64_t a = start; a < end; ) {
+			const uint64_t pageEnd = std::min(end, ((a >> PageShift) + 1) << PageShift);
+			const page& p = _pages[a >> PageShift];
+
+			if (writing && !p.write && p.ram)
+				markDirty(a >> PageShift);
+
+			if (writing ? p.write != nullptr : p.read != nullptr) {
+				fast(p, static_cast<Address>(a & PageMask), a - start, pageEnd - a);
+				if (writing)
+					codeChanged(static_cast<Address>(a), static_cast<Address>(pageEnd - 1));
+			} else {
+				for (uint64_t b = a; b < pageEnd; b++)
+					slow(static_cast<Address>(b), b - start);
+			}
+			a = pageEnd;
+		}
+	}
+
+	// A file's contents as Cells.  Where the host supports it the file is mapped read-only, and
+	// the pages are released when the last user of cells lets go.
+	struct mappedFile {
+		std::shared_ptr<const Cell> cells;
+		size_t size;	// In Cells
+	};
+
+	mappedFile _mapFile(const std::string& filename) {
+#ifdef MEMORY_MMAP
+		int fd = open(filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			std::string message = "File " + filename + " not found";
+			exception(message);
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			close(fd);
+			std::string message = "Error: Failed to read the file " + filename; 
+			exception(message);
+		}
+
+		const size_t bytes = st.st_size;
+		if (bytes < sizeof(Cell)) {
+			close(fd);
+			return { nullptr, 0 };
+		}
+
+		void* image = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (image == MAP_FAILED) {
+			std::string message = "Error: Failed to map the file " + filename; 
+			exception(message);
+		}
+
+		auto unmap = [bytes](const Cell* c) { munmap(const_cast<Cell*>(c), bytes); };
+		return { std::shared_ptr<const Cell>(static_cast<const Cell*>(image), unmap), bytes / sizeof(Cell) };
+#else
+		auto data = std::make_shared<std::vector<Cell>>(_loadDataFromFile(filename));
+		return { std::shared_ptr<const Cell>(data, data->data()), data->size() };
+#endif
+	}
+
 	std::vector<Cell> _loadDataFromFile(const std::string& filename) {
 		std::ifstream file(filename, std::ios::binary);
 		
@@ -754,7 +1761,7 @@ private:
 		return data;
 	}
 
-	void exception(const std::string &message) {
+	void exception(const std::string &message) const {
 		std::string error = "Memory Exception: " + message; 
 		throw Exception(error);
 	}
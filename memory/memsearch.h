@@ -0,0 +1,179 @@
+//
+// Pattern search over snapshots of memory
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+# include <immintrin.h>
+#endif
+
+//
+// MemorySearch finds every occurrence of a set of patterns in a snapshot
+// of memory, such as one taken with Memory::readBlock().  A snapshot can come
+// from any machine, so one search can be run over many of them.
+//
+// Cells are compared after and'ing both sides with a mask, and a pattern
+// cell with no value matches any cell.  A single pattern over byte cells is
+// found by scanning for its first cell 16 or 32 cells at a time with SSE2 or
+// AVX2 where the build targets them.  Anything else uses a Horspool scan
+// that shifts the window by as much as the patterns allow.
+//
+template<class Cell = uint8_t>
+class MemorySearch {
+public:
+	using pattern = std::vector<std::optional<Cell>>;
+
+	struct match {
+		size_t offset;		// Where in the snapshot the pattern starts
+		size_t patternIndex;	// Which pattern matched
+	};
+
+	MemorySearch(const std::vector<pattern>& patterns, const Cell mask = Cell(~Cell(0))) :
+		_patterns(patterns), _mask(mask) {
+
+		_shortest = _patterns.empty() ? 0 : _patterns.front().size();
+		for (const auto& p : _patterns)
+			_shortest = std::min(_shortest, p.size());
+
+		// The window is as long as the shortest pattern.  A cell seen at the end of the window
+		// lets it move up to the next place that cell appears in any pattern, or past it
+		// entirely.  Shifts are indexed by the low byte of a cell, so Cells wider than a byte
+		// share the smallest shift of all the values with the same low byte.
+		_shifts.fill(_shortest);
+		for (const auto& p : _patterns) {
+			for (size_t j = 0; j + 1 < _shortest; j++) {
+				const size_t shift = _shortest - 1 - j;
+				if (p[j]) {
+					auto& s = _shifts[shiftIndex(*p[j])];
+					s = std::min(s, shift);
+				} else {
+					for (auto& s : _shifts)
+						s = std::min(s, shift);
+				}
+			}
+		}
+	}
+
+	// A pattern from the characters in s.  Where wildcard is given, that character matches any
+	// cell, and a backslash makes the character after it literal, so \? matches a '?'.
+	static pattern fromString(const std::string& s, const std::optional<char> wildcard = std::nullopt) {
+		pattern p;
+		for (size_t i = 0; i < s.size(); i++) {
+			if (wildcard && s[i] == '\\' && i + 1 < s.size())
+				p.push_back(static_cast<Cell>(static_cast<unsigned char>(s[++i])));
+			else if (wildcard && s[i] == *wildcard)
+				p.push_back(std::nullopt);
+			else
+				p.push_back(static_cast<Cell>(static_cast<unsigned char>(s[i])));
+		}
+		return p;
+	}
+
+	// Every match in snapshot, ordered by offset and then by pattern
+	std::vector<match> search(const std::span<const Cell> snapshot) const {
+		std::vector<match> matches;
+
+		if (_shortest == 0 || _shortest > snapshot.size())
+			return matches;
+
+		if constexpr (sizeof(Cell) == 1) {
+			if (_patterns.size() == 1 && _patterns.front().front()) {
+				scanFirstCell(snapshot, matches);
+				return matches;
+			}
+		}
+
+		for (size_t offset = 0; offset + _shortest <= snapshot.size(); ) {
+			for (size_t i = 0; i < _patterns.size(); i++) {
+				if (matchesAt(snapshot, offset, _patterns[i]))
+					matches.push_back({ offset, i });
+			}
+			offset += _shifts[shiftIndex(snapshot[offset + _shortest - 1])];
+		}
+
+		return matches;
+	}
+
+private:
+	std::vector<pattern> _patterns;
+	Cell _mask;
+	size_t _shortest;
+	std::array<size_t, 256> _shifts;
+
+	size_t shiftIndex(const Cell c) const {
+		return static_cast<uint8_t>(c & _mask);
+	}
+
+	bool matchesAt(const std::span<const Cell> snapshot, const size_t offset, const pattern& p) const {
+		if (offset + p.size() > snapshot.size())
+			return false;
+		for (size_t j = 0; j < p.size(); j++) {
+			if (p[j] && (snapshot[offset + j] & _mask) != (*p[j] & _mask))
+				return false;
+		}
+		return true;
+	}
+
+	// Find candidates for the only pattern by its first cell, a vector's worth of cells at a time
+	void scanFirstCell(const std::span<const Cell> snapshot, std::vector<match>& matches) const {
+		const pattern& p = _patterns.front();
+		const Cell first = *p.front() & _mask;
+		const size_t candidates = snapshot.size() - p.size() + 1;
+		[[maybe_unused]] const auto data = reinterpret_cast<const char*>(snapshot.data());
+		size_t offset = 0;
+
+		auto check = [&](const size_t at) {
+			if (matchesAt(snapshot, at, p))
+				matches.push_back({ at, 0 });
+		};
+
+#if defined(__AVX2__)
+		const __m256i mask256 = _mm256_set1_epi8(static_cast<char>(_mask));
+		const __m256i first256 = _mm256_set1_epi8(static_cast<char>(first));
+		for (; offset + 32 <= candidates; offset += 32) {
+			const __m256i cells = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+			auto hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(cells, mask256), first256)));
+			for (; hits; hits &= hits - 1)
+				check(offset + std::countr_zero(hits));
+		}
+#endif
+#if defined(__SSE2__)
+		const __m128i mask128 = _mm_set1_epi8(static_cast<char>(_mask));
+		const __m128i first128 = _mm_set1_epi8(static_cast<char>(first));
+		for (; offset + 16 <= candidates; offset += 16) {
+			const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+			auto hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(cells, mask128), first128)));
+			for (; hits; hits &= hits - 1)
+				check(offset + std::countr_zero(hits));
+		}
+#endif
+		for (; offset < candidates; offset++) {
+			if ((snapshot[offset] & _mask) == first)
+				check(offset);
+		}
+	}
+};
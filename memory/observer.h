@@ -0,0 +1,55 @@
+//
+// Observers of memory accesses
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+//
+// A MemoryObserver is attached to ranges of a Memory for any mix of reads,
+// writes and instruction fetches, and is handed the accesses it asked for in
+// batches.  Profilers, coverage and trace tools, and the debugger's watches
+// are all observers.
+//
+// Pages with nothing observing them stay on Memory's fast path, so observers
+// cost nothing until one is attached.  Events are delivered when an
+// observer's batch fills and when the Memory is flushed, which the CPU does
+// when it finishes running.  An observer mustn't attach or detach observers
+// from observe().
+//
+template<class Address, class Cell>
+class MemoryObserver {
+public:
+	enum Access : uint8_t {
+		Read  = 1 << 0,
+		Write = 1 << 1,
+		Fetch = 1 << 2,		// Instruction bytes read by the CPU
+	};
+
+	struct event {
+		Address address;
+		Cell value;			// The value read or written
+		Access access;
+	};
+
+	virtual ~MemoryObserver() = default;
+
+	// Events since the last delivery, oldest first
+	virtual void observe(std::span<const event> events) = 0;
+};
@@ -0,0 +1,82 @@
+//
+// Lock-free single producer, single consumer ring
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+//
+// SPSCRing passes values from one thread to another without locks, such as
+// keys from a device's input thread to the thread running the CPU.  Only one
+// thread may push() and only one may pop().  The head and tail only ever
+// count up, and are masked to index the cells, so a full ring and an empty
+// one are told apart without a spare cell.
+//
+template<class T, size_t Capacity>
+class SPSCRing {
+	static_assert(std::has_single_bit(Capacity), "SPSCRing capacity must be a power of two");
+
+public:
+	// Producer.  Returns false if the ring is full.
+	bool push(const T value) {
+		const auto head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		_cells[head & Mask] = value;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer.  Returns false if the ring is empty.
+	bool pop(T& value) {
+		const auto tail = _tail.load(std::memory_order_relaxed);
+		if (tail == _head.load(std::memory_order_acquire))
+			return false;
+
+		value = _cells[tail & Mask];
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Either side; only a snapshot when the other side is busy
+	bool empty() const {
+		return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+	}
+
+	size_t size() const {
+		const auto tail = _tail.load(std::memory_order_acquire);	// Before the head, so it can't pass it
+		return _head.load(std::memory_order_acquire) - tail;
+	}
+
+	static constexpr size_t capacity() {
+		return Capacity;
+	}
+
+private:
+	static constexpr uint64_t Mask = Capacity - 1;
+
+	// Keep the producer's and consumer's indexes on their own cache lines
+	alignas(64) std::atomic<uint64_t> _head = 0;
+	alignas(64) std::atomic<uint64_t> _tail = 0;
+	std::array<T, Capacity> _cells{};
+};
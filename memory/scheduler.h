@@ -0,0 +1,135 @@
+//
+// Device events timed in CPU cycles
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <memory.h>
+
+//
+// An EventScheduler keeps the events devices have asked for in a min-heap
+// ordered by the CPU cycle they're due at.  The machine runs the CPU for
+// nextSlice() cycles, which ends at the next event, then calls advance()
+// with the cycles the CPU actually used and dispatch() to run whatever came
+// due.  Devices do nothing between events, so the CPU runs without stopping
+// for them.
+//
+// An event scheduled while the CPU is running is timed from the start of the
+// slice.  If it's due before the slice ends the scheduler calls the
+// preemption function, which should stop the CPU, so the event isn't late.
+// Events that repeat should be rescheduled from the cycle they were due at
+// rather than from now() so they don't drift.
+//
+class EventScheduler {
+public:
+	using Cycles = uint64_t;
+
+	EventScheduler(const Cycles maximumSlice = 10000) : _maximumSlice(maximumSlice) { }
+
+	// Keep a device and let it schedule its first events
+	void addDevice(const std::shared_ptr<Device>& device) {
+		_devices.push_back(device);
+		device->startEvents(*this);
+	}
+
+	// Call device.event(..., id) once the CPU reaches cycle when
+	void schedule(Device& device, const Cycles when, const int id) {
+		_events.push_back({ when, _sequence++, &device, id });
+		std::push_heap(_events.begin(), _events.end(), later);
+
+		if (when < _deadline && _preempt)
+			_preempt();
+	}
+
+	void scheduleIn(Device& device, const Cycles delay, const int id) {
+		schedule(device, _now + delay, id);
+	}
+
+	// Drop a device's pending events with this id
+	void cancel(const Device& device, const int id) {
+		std::erase_if(_events, [&](const event& e) { return e.device == &device && e.id == id; });
+		std::make_heap(_events.begin(), _events.end(), later);
+	}
+
+	bool isScheduled(const Device& device, const int id) const {
+		return std::any_of(_events.begin(), _events.end(), [&](const event& e) { return e.device == &device && e.id == id; });
+	}
+
+	// Called when an event is scheduled inside the slice the CPU is running
+	void setPreemption(std::function<void()> preempt) {
+		_preempt = std::move(preempt);
+	}
+
+	// Cycles the CPU can run before the next event is due, at most the maximum slice
+	Cycles nextSlice() {
+		Cycles slice = _maximumSlice;
+		if (!_events.empty())
+			slice = std::min(slice, _events.front().when > _now ? _events.front().when - _now : 0);
+		_deadline = _now + slice;
+		return slice;
+	}
+
+	// The CPU ran for this many cycles
+	void advance(const Cycles cycles) {
+		_now += cycles;
+		_deadline = 0;
+	}
+
+	// Run every event that's due, in the order they're due.  signal is called with each line a
+	// device asserts.
+	template<class F>
+	void dispatch(F&& signal) {
+		while (!_events.empty() && _events.front().when <= _now) {
+			std::pop_heap(_events.begin(), _events.end(), later);
+			const auto e = _events.back();
+			_events.pop_back();
+
+			const auto line = e.device->event(*this, e.when, e.id);
+			if (line != Device::None)
+				signal(line);
+		}
+	}
+
+	Cycles now() const			{ return _now; }
+	size_t pendingEvents() const	{ return _events.size(); }
+
+private:
+	struct event {
+		Cycles when;
+		uint64_t sequence;		// Keeps events due at the same cycle in the order they were scheduled
+		Device* device;
+		int id;
+	};
+
+	static bool later(const event& a, const event& b) {
+		return a.when != b.when ? a.when > b.when : a.sequence > b.sequence;
+	}
+
+	std::vector<std::shared_ptr<Device>> _devices;
+	std::vector<event> _events;
+	std::function<void()> _preempt;
+	Cycles _maximumSlice;
+	Cycles _now = 0;
+	Cycles _deadline = 0;		// End of the slice the CPU is running, or 0 between slices
+	uint64_t _sequence = 0;
+};
@@ -0,0 +1,134 @@
+//
+// Reading and writing machine snapshots
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//
+// A snapshot is a flat buffer of sections, each starting with a four
+// character tag.  Integers are stored least significant byte first, so a
+// snapshot can be restored on any host.  Each part of a machine (the CPU,
+// memory and devices) writes its own section and reads it back in the same
+// order.
+//
+// Restoring is done in two steps so a bad snapshot leaves the machine alone:
+// each part reads its section aside and returns a SnapshotRestore that
+// applies it, and the restores are only run once the whole snapshot has been
+// read.
+//
+
+// Applies state that was read from a snapshot; it mustn't throw
+using SnapshotRestore = std::function<void()>;
+
+// Appends values to a snapshot
+class SnapshotWriter {
+public:
+	SnapshotWriter(std::vector<uint8_t>& buffer) : _buffer(buffer) { }
+
+	void putTag(const char (&tag)[5]) {
+		_buffer.insert(_buffer.end(), tag, tag + 4);
+	}
+
+	template<class T>
+	void put(const T value) {
+		static_assert(std::is_integral_v<T>);
+		for (size_t i = 0; i < sizeof(T); i++)
+			_buffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+	}
+
+	template<class T>
+	void putCells(const std::span<const T> cells) {
+		if constexpr (sizeof(T) == 1) {
+			_buffer.insert(_buffer.end(), cells.begin(), cells.end());
+		} else {
+			for (const auto c : cells)
+				put(c);
+		}
+	}
+
+private:
+	std::vector<uint8_t>& _buffer;
+};
+
+// Reads values back out of a snapshot, in the order they were written
+class SnapshotReader {
+public:
+	SnapshotReader(const std::span<const uint8_t> data) : _data(data) { }
+
+	void expectTag(const char (&tag)[5]) {
+		need(4);
+		if (std::memcmp(_data.data() + _position, tag, 4) != 0)
+			throw Exception(std::string("Snapshot section '") + tag + "' not found");
+		_position += 4;
+	}
+
+	template<class T>
+	T get() {
+		static_assert(std::is_integral_v<T>);
+		need(sizeof(T));
+		uint64_t value = 0;
+		for (size_t i = 0; i < sizeof(T); i++)
+			value |= static_cast<uint64_t>(_data[_position++]) << (8 * i);
+		return static_cast<T>(value);
+	}
+
+	template<class T>
+	void getCells(const std::span<T> cells) {
+		if constexpr (sizeof(T) == 1) {
+			need(cells.size());
+			std::memcpy(cells.data(), _data.data() + _position, cells.size());
+			_position += cells.size();
+		} else {
+			for (auto& c : cells)
+				c = get<T>();
+		}
+	}
+
+	bool atEnd() const {
+		return _position == _data.size();
+	}
+
+	class Exception : public std::exception {
+	public:
+		Exception(const std::string& msg) : message("Snapshot Exception: " + msg) {}
+
+		const char* what() const noexcept override {
+			return message.c_str();
+		}
+
+	private:
+		std::string message;
+	};
+
+private:
+	std::span<const uint8_t> _data;
+	size_t _position = 0;
+
+	void need(const size_t bytes) const {
+		if (_data.size() - _position < bytes)
+			throw Exception("data ends early");
+	}
+};
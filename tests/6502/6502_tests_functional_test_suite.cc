@@ -44,22 +44,25 @@ public:
 	void runProgram() {
 		const char cursorChars[] = {'|', '/', '-', '\\'};
 		const int numChars = sizeof(cursorChars) / sizeof(char);
-		uint64_t instructionCount = 0;
 		uint8_t cursorCount = 0;
 
+		// Run a million instructions at a time, updating the cursor in between.  Drop back to 
+		// execute() if a failure has landed us in the debugger.
 		while (!cpu.isPCAtHaltAddress()) {
-			cpu.execute();
-
-			if (instructionCount % 1000000 == 0) {
-				std::cout << cursorChars[cursorCount % numChars] << std::flush;
-				std::cout << "\b" << std::flush;
-				cursorCount++;
+			if (cpu.isInDebugMode()) {
+				cpu.execute();
+				continue;
 			}
-			instructionCount++;
+
+			cpu.runInstructions(1000000);
+
+			std::cout << cursorChars[cursorCount % numChars] << std::flush;
+			std::cout << "\b" << std::flush;
+			cursorCount++;
 		}
 		std::cout << " \b" << std::flush;
 	}
 };
 
 #define testClass MOS6502FunctionalTestSuite
-#include "functional_tests.cc"
\ No newline at end of file
+#include "functional_tests.cc"
\ No newline at end of file
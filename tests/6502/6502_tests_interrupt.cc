@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 #include <6502.h>
+#include <scheduler.h>
 #include <thread>
 
 class MOS6502InterruptTests : public testing::Test {
@@ -43,4 +44,4 @@ public:
 };
 
 #define testClass MOS6502InterruptTests
-#include "interrupt_tests.cc"
\ No newline at end of file
+#include "interrupt_tests.cc"
\ No newline at end of file
@@ -0,0 +1,37 @@
+//
+// Tests for machine snapshots
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <6502.h>
+
+class MOS6502SnapshotTests : public testing::Test {
+public:
+
+	Memory<Word, Byte> mem{MOS6502::LAST_ADDRESS};
+	MOS6502 cpu{mem};
+
+	virtual void SetUp() {
+		mem.mapRAM(0, MOS6502::LAST_ADDRESS);
+	}
+
+	virtual void TearDown()	{
+	}
+};
+
+#define testClass MOS6502SnapshotTests
+#include "snapshot_tests.cc"
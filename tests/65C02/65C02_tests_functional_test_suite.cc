@@ -31,7 +31,7 @@
 class MOS65C02FunctionalTestSuite : public testing::Test {
 public:	
 	Memory<Word, Byte> mem{MOS65C02::LAST_ADDRESS};
-	MOS65C02 cpu{mem};
+	R65C02 cpu{mem};
 	bool debug;
 
 	virtual void SetUp() {
@@ -47,18 +47,21 @@ public:
 	void runProgram() {
 		const char cursorChars[] = {'|', '/', '-', '\\'};
 		const int numChars = sizeof(cursorChars) / sizeof(char);
-		uint64_t instructionCount = 0;
 		uint8_t cursorCount = 0;
 
+		// Run a million instructions at a time, updating the cursor in between.  Drop back to 
+		// execute() if a failure has landed us in the debugger.
 		while (!cpu.isPCAtHaltAddress()) {
-			cpu.execute();
-
-			if (instructionCount % 1000000 == 0) {
-				std::cout << cursorChars[cursorCount % numChars] << std::flush;
-				std::cout << "\b" << std::flush;
-				cursorCount++;
+			if (cpu.isInDebugMode()) {
+				cpu.execute();
+				continue;
 			}
-			instructionCount++;
+
+			cpu.runInstructions(1000000);
+
+			std::cout << cursorChars[cursorCount % numChars] << std::flush;
+			std::cout << "\b" << std::flush;
+			cursorCount++;
 		}
 		std::cout << " \b" << std::flush;
 	}
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 #include <65C02.h>
+#include <scheduler.h>
 #include <thread>
 
 
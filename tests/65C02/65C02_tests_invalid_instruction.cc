@@ -34,4 +34,17 @@ public:
 };
 
 #define testClass MOS65C02OpcodeTests
-#include "invalid_instruction_tests.cc"
\ No newline at end of file
+#include "invalid_instruction_tests.cc"
+
+TEST_F(MOS65C02OpcodeTests, BitInstructionsAreOnlyOnTheR65C02) {
+        //Given:
+        R65C02 rockwell{mem};
+        cpu.TestReset(MOS6502::RESET_VECTOR);
+        rockwell.TestReset(MOS6502::RESET_VECTOR);
+        mem[0xFFFC] = rockwell.Opcodes.RMB0;
+        mem[0xFFFD] = 0x10;
+
+        //When/Expect:
+        EXPECT_THROW(cpu.execute(), std::runtime_error);
+        EXPECT_NO_THROW(rockwell.execute());
+}
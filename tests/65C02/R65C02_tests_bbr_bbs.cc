@@ -23,7 +23,7 @@ class MOS65C02BBS_BBRTests : public testing::Test {
 public:
 
 	Memory<Word, Byte> mem{MOS65C02::LAST_ADDRESS};
-	MOS65C02 cpu{mem};
+	R65C02 cpu{mem};
 
 	virtual void SetUp() {
 		mem.mapRAM(0, MOS65C02::LAST_ADDRESS);
@@ -19,6 +19,23 @@
 #include <gtest/gtest.h>
 #include <clock.h>
 
+// A clock that only moves when a test advances it, or the bus clock sleeps on it
+struct FakeClock {
+	using rep = int64_t;
+	using period = std::nano;
+	using duration = std::chrono::nanoseconds;
+	using time_point = std::chrono::time_point<FakeClock>;
+	static constexpr bool is_steady = true;
+
+	static inline time_point current{};
+
+	static time_point now() { return current; }
+	static void sleep_until(const time_point t) { current = std::max(current, t); }
+	static void advance(const duration d) { current += d; }
+};
+
+using FakeBusClock = BasicBusClock<FakeClock>;
+
 class ClockTests : public testing::Test {
 public:
 	virtual void SetUp() { }
@@ -118,3 +135,76 @@ TEST_F(ClockTests, CantSetHighMHz) {
     BusClock_t clock(1001);
     EXPECT_EQ(clock.getFrequencyMHz(), 1000);
 }
+
+TEST_F(ClockTests, DelayPacesToTheDeadline) {
+    FakeBusClock clock(1);
+    uint64_t slice = clock.getCyclesInDelayTime();
+
+    clock.setSpinTime(0ns);
+    clock.enableTimingEmulation();
+    auto start = FakeClock::now();
+    for (int i = 0; i < 10; i++)
+        clock.delay(slice);
+
+    // The first delay starts the clock, so nine slices have to pass
+    EXPECT_EQ(FakeClock::now() - start, 9 * clock.minimumDelayTime());
+    EXPECT_EQ(clock.getStats().delays, 10u);
+    EXPECT_EQ(clock.getStats().drift, 0ns);
+    EXPECT_DOUBLE_EQ(clock.getStats().effectiveMHz, 1.0);
+}
+
+TEST_F(ClockTests, DelayDoesntSleepWhenBehind) {
+    FakeBusClock clock(1);
+    uint64_t slice = clock.getCyclesInDelayTime();
+
+    clock.setSpinTime(0ns);
+    clock.enableTimingEmulation();
+    clock.delay(slice);
+    FakeClock::advance(20ms);
+    auto behind = FakeClock::now();
+    clock.delay(slice);
+
+    EXPECT_EQ(FakeClock::now(), behind);
+}
+
+TEST_F(ClockTests, SkipPolicyForgetsLag) {
+    FakeBusClock clock(1);
+    uint64_t slice = clock.getCyclesInDelayTime();
+
+    clock.setSpinTime(0ns);
+    clock.enableTimingEmulation();
+    clock.setCatchUpPolicy(FakeBusClock::CatchUp::Skip);
+    clock.delay(slice);
+    FakeClock::advance(50ms);
+    clock.delay(slice);
+
+    // The second slice was due 5ms after the first
+    EXPECT_EQ(clock.getStats().skipped, 45ms);
+    EXPECT_EQ(clock.getStats().drift, 0ns);
+
+    // ...and pacing carries on from now
+    auto now = FakeClock::now();
+    clock.delay(slice);
+    EXPECT_EQ(FakeClock::now() - now, clock.minimumDelayTime());
+}
+
+TEST_F(ClockTests, BurstPolicyKeepsLagUpToTheMaximum) {
+    FakeBusClock clock(1);
+    uint64_t slice = clock.getCyclesInDelayTime();
+
+    clock.setSpinTime(0ns);
+    clock.enableTimingEmulation();
+    clock.setMaximumLag(10ms);
+    clock.delay(slice);
+    FakeClock::advance(50ms);
+    clock.delay(slice);
+
+    EXPECT_EQ(clock.getStats().skipped, 35ms);
+    EXPECT_EQ(clock.getStats().drift, 10ms);
+
+    // The 10ms kept is made up by running the next two slices without sleeping
+    auto now = FakeClock::now();
+    clock.delay(slice);
+    clock.delay(slice);
+    EXPECT_EQ(FakeClock::now(), now);
+}
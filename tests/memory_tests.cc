@@ -18,7 +18,10 @@
 
 #include <gtest/gtest.h>
 #include <memory.h>
+#include <scheduler.h>
+#include <ring.h>
 #include <cstdint>
+#include <thread>
 
 class MemoryTests : public testing::Test {
 public:
@@ -127,6 +130,37 @@ TEST_F(MemoryTests,CanLoadDataIntoMemory) {
 		EXPECT_EQ(mem[i], 0xef);
 }
 
+// Code tracking tests
+TEST_F(MemoryTests, WritesToMarkedCodePagesAreReported) {
+	Memory<Address, Cell> mem(0x1000);
+	std::vector<Address> changed;
+
+	mem.mapRAM(0, 0x1000);
+	mem.setCodeChangedCallback([&](Address a) { changed.push_back(a); });
+	mem.markCodePage(0x0210);
+
+	mem[0x0100] = 1;
+	mem[0x0300] = 1;
+	EXPECT_TRUE(changed.empty());
+
+	mem[0x0234] = 1;
+	ASSERT_EQ(changed.size(), 1);
+	EXPECT_EQ(changed[0], 0x0234);
+}
+
+TEST_F(MemoryTests, LoadsIntoMarkedCodePagesAreReported) {
+	Memory<Address, Cell> mem(0x1000);
+	std::vector<Address> changed;
+	std::vector<Cell> data = { 1, 2, 3, 4 };
+
+	mem.mapRAM(0, 0x1000);
+	mem.setCodeChangedCallback([&](Address a) { changed.push_back(a); });
+	mem.markCodePage(0x0200);
+
+	mem.loadData(data, 0x01fe);
+	EXPECT_EQ(changed, std::vector<Address>({ 0x0200, 0x0201 }));
+}
+
 // ROM tests
 TEST_F(MemoryTests, ROMRead) {
 	Memory<Address, Cell> mem(0x1000);
@@ -151,7 +185,552 @@ TEST_F(MemoryTests, ROMThrowsAwayReads) {
 	EXPECT_EQ(mem[0], 0x10);
 }
 
+TEST_F(MemoryTests, ROMLoadedFromFileIsReadOnly) {
+	Memory<Address, Cell> mem(0x1000);
+	const std::vector<Cell> image(0x180, 0x10);
+	const std::string filename = testing::TempDir() + "memory_tests_rom.bin";
+
+	std::ofstream(filename, std::ios::binary).write(reinterpret_cast<const char*>(image.data()), image.size() * sizeof(Cell));
+	mem.mapRAM(0, 0x1000);
+	mem.loadRomFromFile(filename.c_str(), 0x140);
+	std::remove(filename.c_str());
+
+	mem[0x13f] = 0x20;
+	mem[0x140] = 0x20;
+	mem[0x200] = 0x20;
+	mem[0x2c0] = 0x20;
+	EXPECT_EQ(mem[0x13f], 0x20);
+	EXPECT_EQ(mem[0x140], 0x10);
+	EXPECT_EQ(mem[0x200], 0x10);
+	EXPECT_EQ(mem[0x2bf], 0x10);
+	EXPECT_EQ(mem[0x2c0], 0x20);
+}
+
+Cell mio_byte;
+void miowrite(Cell b) {
+	mio_byte = b;
+}
+
+Cell mioread() {
+	return mio_byte;
+}
+
+TEST_F(MemoryTests, BlockReadsAndWritesCrossDevicesAndPages) {
+	Memory<Address, Cell> mem(0x1000);
+	std::vector<Cell> data(0x300);
+
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = i + 1;
+	mio_byte = 0;
+	mem.mapRAM(0, 0x1000);
+	mem.mapMIO(0x280, mioread, miowrite);
+
+	mem.writeBlock(0x100, data);
+	EXPECT_EQ(mio_byte, 0x181);
+
+	auto out = mem.readBlock(0x0ff, 0x400);
+	EXPECT_EQ(out.size(), 0x302u);
+	EXPECT_EQ(out[0], 0);
+	EXPECT_EQ(out[1], 1);
+	EXPECT_EQ(out[0x180], 0x180);
+	EXPECT_EQ(out[0x181], 0x181);
+	EXPECT_EQ(out[0x182], 0x182);
+	EXPECT_EQ(out[0x300], 0x300);
+	EXPECT_EQ(out[0x301], 0);
+}
+
+TEST_F(MemoryTests, FillAndOverlappingCopy) {
+	Memory<Address, Cell> mem(0x1000);
+
+	mem.mapRAM(0, 0x1000);
+	mem.fill(0x100, 0x2ff, 0x42);
+	EXPECT_EQ(mem[0x0ff], 0);
+	EXPECT_EQ(mem[0x100], 0x42);
+	EXPECT_EQ(mem[0x2ff], 0x42);
+	EXPECT_EQ(mem[0x300], 0);
+
+	mem[0x100] = 1;
+	mem.copy(0x100, 0x2ff, 0x101);
+	EXPECT_EQ(mem[0x101], 1);
+	EXPECT_EQ(mem[0x102], 0x42);
+	EXPECT_EQ(mem[0x300], 0x42);
+	using Exception = Memory<Address, Cell>::Exception;
+	EXPECT_THROW(mem.fill(0xf00, 0x1001, 0), Exception);
+}
+
+TEST_F(MemoryTests, RemappingPartOfARAMPageKeepsTheRestWritable) {
+	Memory<Address, Cell> mem(0x1000);
+
+	mio_byte = 0;
+	mem.mapRAM(0, 0x1000);
+	mem[0x110] = 0x42;
+	mem.mapROM(0x180, std::vector<Cell>{ 0x10 });
+	mem.mapMIO(0x190, mioread, miowrite);
+
+	mem[0x110] = 0x43;
+	mem[0x180] = 0x44;
+	mem[0x190] = 0x45;
+	EXPECT_EQ(mem[0x110], 0x43);
+	EXPECT_EQ(mem[0x180], 0x10);
+	EXPECT_EQ(mio_byte, 0x45);
+}
+
+TEST_F(MemoryTests, UnmappingTheMiddleOfARegionSplitsIt) {
+	Memory<Address, Cell> mem(0x1000);
+
+	mem.mapRAM(0, 0xfff);
+	mem[0x0ff] = 1;
+	mem[0x200] = 2;
+	mem.unmap(0x100, 0x1ff);
+
+	mem[0x150] = 3;
+	EXPECT_TRUE(mem.isAddressMapped(0x0ff));
+	EXPECT_FALSE(mem.isAddressMapped(0x100));
+	EXPECT_FALSE(mem.isAddressMapped(0x1ff));
+	EXPECT_TRUE(mem.isAddressMapped(0x200));
+	EXPECT_EQ(mem[0x0ff], 1);
+	EXPECT_EQ(mem[0x150], 0);
+	EXPECT_EQ(mem[0x200], 2);
+}
+
+TEST_F(MemoryTests, OverlapInsideAnExistingRegionIsDetected) {
+	Memory<Address, Cell> mem(0x1000);
+
+	using Exception = Memory<Address, Cell>::Exception;
+	const std::vector<Cell> rom = { 1, 2 };
+
+	mem.mapRAM(0x100, 0x1ff);
+	EXPECT_THROW(mem.mapROM(0x180, rom, false), Exception);
+	EXPECT_NO_THROW(mem.mapROM(0x200, rom, false));
+	EXPECT_THROW(mem.mapRAM(0x000, 0x100), Exception);
+}
+
+// Search tests
+TEST_F(MemoryTests, FindReturnsEveryMatchingAddress) {
+	Memory<uint16_t, uint8_t> mem(0x1000);
+	const std::string hello = "HELLO";
+
+	mem.mapRAM(0, 0x1000);
+	mem.loadData(std::vector<uint8_t>(hello.begin(), hello.end()), 0x0123);
+	mem.loadData({ 'H' | 0x80, 'E' | 0x80, 'L' | 0x80, 'L' | 0x80, 'O' | 0x80 }, 0x0ffb);
+
+	EXPECT_EQ(mem.find("HELLO"), std::vector<uint16_t>({ 0x0123 }));
+	EXPECT_EQ(mem.find("HELLO", 0x7f), std::vector<uint16_t>({ 0x0123, 0x0ffb }));
+	EXPECT_TRUE(mem.find("HELLO!").empty());
+}
+
+TEST_F(MemoryTests, SearchFindsSeveralPatternsWithWildcards) {
+	using Search = MemorySearch<uint8_t>;
+	const std::string text = "PRINT A: GOTO 10: PRINT B: GOSUB 20";
+	const std::vector<uint8_t> snapshot(text.begin(), text.end());
+
+	Search search({ Search::fromString("PRINT ?", '?'), Search::fromString("GO??? ", '?'), Search::fromString("B") }, 0xff);
+	auto matches = search.search(snapshot);
+
+	ASSERT_EQ(matches.size(), 5u);
+	EXPECT_EQ(matches[0].offset, 0u);
+	EXPECT_EQ(matches[0].patternIndex, 0u);
+	EXPECT_EQ(matches[1].offset, 18u);
+	EXPECT_EQ(matches[1].patternIndex, 0u);
+	EXPECT_EQ(matches[2].offset, 24u);
+	EXPECT_EQ(matches[2].patternIndex, 2u);
+	EXPECT_EQ(matches[3].offset, 27u);
+	EXPECT_EQ(matches[3].patternIndex, 1u);
+	EXPECT_EQ(matches[4].offset, 31u);
+	EXPECT_EQ(matches[4].patternIndex, 2u);
+}
+
+TEST_F(MemoryTests, SearchDoesntReadDevices) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	static int reads = 0;
+	const std::string hello = "HELLO";
+	mem.mapRAM(0, 0xfeff);
+	mem.mapMIO(0xff00, []() -> uint8_t { return ++reads; }, nullptr);
+	mem.loadData(std::vector<uint8_t>(hello.begin(), hello.end()), 0xfefb);
+
+	EXPECT_EQ(mem.find("HELLO"), std::vector<uint16_t>({ 0xfefb }));
+	EXPECT_TRUE(mem.find(std::string("O\0", 2)).empty());
+	EXPECT_EQ(reads, 0);
+}
+
+TEST_F(MemoryTests, SearchEscapesTheWildcard) {
+	using Search = MemorySearch<uint8_t>;
+	const std::string text = "A? AB A\\";
+	const std::vector<uint8_t> snapshot(text.begin(), text.end());
+
+	auto matches = Search({ Search::fromString("A\\?", '?'), Search::fromString("A\\\\", '?') }).search(snapshot);
+
+	ASSERT_EQ(matches.size(), 2u);
+	EXPECT_EQ(matches[0].offset, 0u);
+	EXPECT_EQ(matches[0].patternIndex, 0u);
+	EXPECT_EQ(matches[1].offset, 6u);
+	EXPECT_EQ(matches[1].patternIndex, 1u);
+	EXPECT_EQ(Search({ Search::fromString("A?", '?') }).search(snapshot).size(), 3u);
+}
+
+TEST_F(MemoryTests, SearchWideCellsWithMask) {
+	using Search = MemorySearch<Cell>;
+	const std::vector<Cell> snapshot = { 0x100, 0x201, 0x302, 0x001, 0x102, 0x203, 0x01 };
+
+	auto matches = Search({ Search::pattern{ 1, 2 } }, 0xff).search(snapshot);
+	ASSERT_EQ(matches.size(), 2u);
+	EXPECT_EQ(matches[0].offset, 1u);
+	EXPECT_EQ(matches[1].offset, 3u);
+	EXPECT_TRUE(Search({ Search::pattern{ 1, 2 } }).search(snapshot).empty());
+}
+
 // MIO tests
+TEST_F(MemoryTests, WritesMarkTheirPagesDirty) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	mem.mapRAM(0, 0xffff);
+	mem.checkpoint();
+	EXPECT_TRUE(mem.dirtyPages().empty());
+
+	mem[0x1234] = 1;
+	mem[0x1256] = 2;
+	mem.fill(0x40ff, 0x4100, 3);
+
+	std::vector<uint16_t> expected = { 0x1200, 0x4000, 0x4100 };
+	EXPECT_EQ(mem.dirtyPages(), expected);
+	EXPECT_TRUE(mem.isPageDirty(0x12ff));
+	EXPECT_FALSE(mem.isPageDirty(0x1300));
+}
+
+TEST_F(MemoryTests, ResetGoesBackToTheCheckpoint) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	mem.mapRAM(0, 0xefff);
+	mem.mapROM(0xf000, std::vector<uint8_t>(0x1000, 0xea));
+	mem[0x0200] = 0x42;
+	mem.checkpoint();
+
+	mem[0x0200] = 0x43;
+	mem[0x8000] = 0x44;
+	mem.unmap(0x8000, 0x8fff);
+	mem.Reset();
+
+	EXPECT_EQ(mem[0x0200], 0x42);
+	EXPECT_EQ(mem[0x8000], 0);
+	EXPECT_EQ(mem[0xf000], 0xea);
+	EXPECT_TRUE(mem.isAddressMapped(0x8000));
+	EXPECT_TRUE(mem.dirtyPages().empty());
+
+	mem[0x8000] = 0x45;
+	EXPECT_EQ(mem[0x8000], 0x45);
+}
+
+TEST_F(MemoryTests, ResetWithoutACheckpointEmptiesMemory) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	mem.mapRAM(0, 0xffff);
+	mem[0x1000] = 0x42;
+	mem.Reset();
+
+	EXPECT_FALSE(mem.isAddressMapped(0x1000));
+	mem.mapRAM(0, 0xffff);
+	EXPECT_EQ(mem[0x1000], 0);
+}
+
+TEST_F(MemoryTests, DeltaCarriesDirtyPagesToAnotherMemory) {
+	Memory<uint16_t, uint16_t> source(0x1000);
+	Memory<uint16_t, uint16_t> target(0x1000);
+	source.mapRAM(0, 0x1000);
+	target.mapRAM(0, 0x1000);
+	source.checkpoint();
+	target.checkpoint();
+
+	source[0x0010] = 0x1234;
+	source[0x1000] = 0xbeef;
+	std::vector<uint8_t> delta;
+	SnapshotWriter writer(delta);
+	source.saveDelta(writer);
+	SnapshotReader reader(delta);
+	target.applyDelta(reader);
+
+	EXPECT_EQ(target[0x0010], 0x1234);
+	EXPECT_EQ(target[0x1000], 0xbeef);
+	EXPECT_EQ(target.dirtyPages(), source.dirtyPages());
+
+	delta.resize(delta.size() - 1);
+	SnapshotReader truncated(delta);
+	EXPECT_THROW(target.applyDelta(truncated), SnapshotReader::Exception);
+}
+
+class recordingObserver : public MemoryObserver<uint16_t, uint8_t> {
+public:
+	std::vector<event> events;
+
+	void observe(const std::span<const event> batch) override {
+		events.insert(events.end(), batch.begin(), batch.end());
+	}
+};
+
+TEST_F(MemoryTests, ObserversSeeTheirRangesAndAccesses) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto observer = std::make_shared<recordingObserver>();
+	mem.mapRAM(0, 0xffff);
+	mem.attachObserver(observer, 0x10, 0x1f, recordingObserver::Write);
+
+	mem[0x10] = 1;
+	mem[0x20] = 2;
+	uint8_t value = mem[0x10];
+	mem.flushObservers();
+
+	EXPECT_EQ(value, 1);
+	ASSERT_EQ(observer->events.size(), 1u);
+	EXPECT_EQ(observer->events[0].address, 0x10);
+	EXPECT_EQ(observer->events[0].value, 1);
+	EXPECT_EQ(observer->events[0].access, recordingObserver::Write);
+	EXPECT_TRUE(mem.isObserved(0x1f, recordingObserver::Write));
+	EXPECT_FALSE(mem.isObserved(0x1f, recordingObserver::Read));
+	EXPECT_FALSE(mem.isObserved(0x20, recordingObserver::Write));
+}
+
+TEST_F(MemoryTests, ObserverEventsAreDeliveredInBatches) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto observer = std::make_shared<recordingObserver>();
+	mem.mapRAM(0, 0xffff);
+	mem.attachObserver(observer, 0x1000, 0x10ff, recordingObserver::Read);
+
+	for (int i = 0; i < 300; i++)
+		mem.Read(0x1000);
+	EXPECT_EQ(observer->events.size() % 256, 0u);
+	EXPECT_GT(observer->events.size(), 0u);
+
+	mem.flushObservers();
+	EXPECT_EQ(observer->events.size(), 300u);
+}
+
+TEST_F(MemoryTests, DetachedObserversSeeNothing) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto observer = std::make_shared<recordingObserver>();
+	mem.mapRAM(0, 0xffff);
+	mem.attachObserver(observer, 0x10, 0x10, recordingObserver::Write);
+	mem.enableWatch(0x11);
+	mem.detachObserver(observer);
+
+	mem[0x10] = 1;
+	mem[0x11] = 2;
+	mem.flushObservers();
+
+	EXPECT_TRUE(observer->events.empty());
+	EXPECT_FALSE(mem.isObserved(0x10, recordingObserver::Write));
+	EXPECT_TRUE(mem.watching(0x11));
+	mem.clearWatch(0x11);
+	EXPECT_FALSE(mem.isObserved(0x11, recordingObserver::Write));
+	EXPECT_EQ(mem[0x11], 2);
+}
+
+TEST_F(MemoryTests, PeekDoesntReadOrReport) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto observer = std::make_shared<recordingObserver>();
+	static int reads = 0;
+	mem.mapRAM(0, 0xfeff);
+	mem.mapMIO(0xff00, []() -> uint8_t { return ++reads; }, nullptr);
+	mem[0x10] = 0x42;
+	mem.attachObserver(observer, 0x10, 0x10, recordingObserver::Read | recordingObserver::Fetch);
+
+	EXPECT_EQ(mem.Peek(0x10), 0x42);
+	EXPECT_EQ(mem.Peek(0xff00), 0);
+	mem.flushObservers();
+
+	EXPECT_EQ(observer->events.size(), 0u);
+	EXPECT_EQ(reads, 0);
+}
+
+TEST_F(MemoryTests, BanksSwitchUnderTheirWindow) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto banks = std::make_shared<BankedMemory<uint16_t, uint8_t>>(0x4000, 32);
+	mem.mapRAM(0, 0xffff);
+	mem.mapBanks(banks, 0x4000);
+
+	mem[0x4000] = 1;
+	mem[0x7fff] = 1;
+	banks->select(1);
+	EXPECT_EQ(mem[0x4000], 0);
+	mem[0x4000] = 2;
+	mem.fill(0x7f00, 0x8000, 3);
+
+	banks->select(0);
+	EXPECT_EQ(mem[0x4000], 1);
+	EXPECT_EQ(mem[0x7fff], 1);
+	EXPECT_EQ(mem[0x8000], 3);
+	banks->select(1);
+	EXPECT_EQ(mem[0x4000], 2);
+	EXPECT_EQ(mem[0x7fff], 3);
+	EXPECT_THROW(banks->select(32), std::out_of_range);
+}
+
+TEST_F(MemoryTests, BankSelectRegisterSwitchesBanks) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto overlays = std::make_shared<BankedMemory<uint16_t, uint8_t>>(0x2000, 2, false);
+	overlays->load(0, std::vector<uint8_t>(0x2000, 0xa0));
+	overlays->load(1, std::vector<uint8_t>(0x2000, 0xa1));
+	mem.mapRAM(0, 0xdfff);
+	mem.mapBanks(overlays, 0xe000);
+	mem.mapDevice(std::make_shared<BankSelect<uint16_t, uint8_t>>(overlays), 0xc0f0);
+
+	mem[0xc0f0] = 3;
+	mem[0xe000] = 0;
+
+	EXPECT_EQ(overlays->selected(), 1u);
+	EXPECT_EQ(mem[0xc0f0], 1);
+	EXPECT_EQ(mem[0xe000], 0xa1);
+	EXPECT_EQ(mem[0xffff], 0xa1);
+}
+
+TEST_F(MemoryTests, SnapshotsKeepTheSelectedBank) {
+	Memory<uint16_t, uint8_t> mem(0xffff);
+	auto banks = std::make_shared<BankedMemory<uint16_t, uint8_t>>(0x1000, 4);
+	mem.mapRAM(0, 0xffff);
+	mem.mapBanks(banks, 0x8000);
+	banks->select(2);
+	mem[0x8000] = 0x42;
+
+	std::vector<uint8_t> snapshot;
+	SnapshotWriter writer(snapshot);
+	mem.saveState(writer);
+	mem[0x8000] = 0x43;
+	banks->select(3);
+	SnapshotReader reader(snapshot);
+	mem.restoreState(reader);
+
+	EXPECT_EQ(banks->selected(), 2u);
+	EXPECT_EQ(mem[0x8000], 0x42);
+}
+
+// A device that records the events it's handed, and can repeat or raise a line on some
+class timedDevice : public Device {
+public:
+	std::vector<std::pair<uint64_t, int>> events;
+	uint64_t period = 0;		// Reschedule every event this long after it was due
+	Lines line = None;
+
+	Lines event(EventScheduler& scheduler, const uint64_t cycle, const int id) override {
+		events.push_back({ cycle, id });
+		if (period)
+			scheduler.schedule(*this, cycle + period, id);
+		return line;
+	}
+};
+
+TEST_F(MemoryTests, SchedulerRunsEventsInCycleOrder) {
+	EventScheduler scheduler(1000);
+	auto device = std::make_shared<timedDevice>();
+	std::vector<Device::Lines> signals;
+	device->line = Device::IRQ;
+	scheduler.addDevice(device);
+	scheduler.schedule(*device, 300, 3);
+	scheduler.schedule(*device, 100, 1);
+	scheduler.schedule(*device, 300, 4);
+	scheduler.schedule(*device, 200, 2);
+
+	EXPECT_EQ(scheduler.nextSlice(), 100u);
+	scheduler.advance(250);
+	scheduler.dispatch([&](const Device::Lines l) { signals.push_back(l); });
+	EXPECT_EQ(device->events.size(), 2u);
+	EXPECT_EQ(scheduler.nextSlice(), 50u);
+	scheduler.advance(50);
+	scheduler.dispatch([&](const Device::Lines l) { signals.push_back(l); });
+
+	ASSERT_EQ(device->events.size(), 4u);
+	for (int i = 0; i < 4; i++)
+		EXPECT_EQ(device->events[i].second, i + 1);
+	EXPECT_EQ(device->events[0].first, 100u);
+	EXPECT_EQ(device->events[3].first, 300u);
+	EXPECT_EQ(signals.size(), 4u);
+	EXPECT_EQ(scheduler.nextSlice(), 1000u);
+}
+
+TEST_F(MemoryTests, RepeatingEventsDontDrift) {
+	EventScheduler scheduler(1000);
+	auto device = std::make_shared<timedDevice>();
+	device->period = 100;
+	scheduler.addDevice(device);
+	scheduler.schedule(*device, 100, 0);
+
+	// Slices that overrun the event by a few cycles, as the CPU's last instruction does
+	for (int i = 0; i < 10; i++) {
+		scheduler.advance(scheduler.nextSlice() + 3);
+		scheduler.dispatch([](Device::Lines) { });
+	}
+
+	ASSERT_EQ(device->events.size(), 10u);
+	EXPECT_EQ(device->events[9].first, 1000u);
+	EXPECT_EQ(scheduler.now(), 1003u);
+}
+
+TEST_F(MemoryTests, EventsInsideTheRunningSlicePreemptIt) {
+	EventScheduler scheduler(1000);
+	auto device = std::make_shared<timedDevice>();
+	int preempted = 0;
+	scheduler.addDevice(device);
+	scheduler.setPreemption([&] { preempted++; });
+
+	scheduler.schedule(*device, 10, 0);
+	EXPECT_EQ(preempted, 0);
+	scheduler.nextSlice();
+	scheduler.scheduleIn(*device, 2000, 1);
+	EXPECT_EQ(preempted, 0);
+	scheduler.scheduleIn(*device, 5, 2);
+	EXPECT_EQ(preempted, 1);
+
+	scheduler.cancel(*device, 0);
+	EXPECT_FALSE(scheduler.isScheduled(*device, 0));
+	EXPECT_TRUE(scheduler.isScheduled(*device, 2));
+	scheduler.advance(5);
+	scheduler.dispatch([](Device::Lines) { });
+	ASSERT_EQ(device->events.size(), 1u);
+	EXPECT_EQ(device->events[0].second, 2);
+	EXPECT_EQ(scheduler.pendingEvents(), 1u);
+}
+
+TEST_F(MemoryTests, RingKeepsOrderUntilFull) {
+	SPSCRing<uint8_t, 4> ring;
+	uint8_t value = 0;
+
+	EXPECT_FALSE(ring.pop(value));
+	for (uint8_t i = 0; i < 4; i++)
+		EXPECT_TRUE(ring.push(i));
+	EXPECT_FALSE(ring.push(4));
+	EXPECT_EQ(ring.size(), 4u);
+
+	// Wrap around the end of the cells
+	for (uint8_t i = 0; i < 6; i++) {
+		ASSERT_TRUE(ring.pop(value));
+		EXPECT_EQ(value, i);
+		EXPECT_TRUE(ring.push(i + 4));
+	}
+	EXPECT_EQ(ring.size(), 4u);
+	EXPECT_FALSE(ring.empty());
+}
+
+TEST_F(MemoryTests, RingPassesValuesBetweenThreads) {
+	SPSCRing<uint32_t, 64> ring;
+	constexpr uint32_t count = 100000;
+
+	std::thread producer([&] {
+		for (uint32_t i = 0; i < count; i++) {
+			while (!ring.push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	uint32_t expected = 0;
+	bool inOrder = true;
+	while (expected < count) {
+		uint32_t value;
+		if (!ring.pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		inOrder = inOrder && value == expected;
+		expected++;
+	}
+	producer.join();
+
+	EXPECT_TRUE(inOrder);
+	EXPECT_TRUE(ring.empty());
+}
+
 TEST_F(MemoryTests, MIONullWriteThrowsAwayWrite) {
 	Memory<Address, Cell> mem(0x1000);
 
@@ -169,15 +748,6 @@ TEST_F(MemoryTests, MIONullReadReturnsZero) {
 	EXPECT_EQ(mem[0x100], 0x0);
 }
 
-Cell mio_byte;
-void miowrite(Cell b) {
-	mio_byte = b;
-}
-
-Cell mioread() {
-	return mio_byte;
-}
-
 TEST_F(MemoryTests, MIOWrite) {
 	Memory<Address, Cell> mem(0x1000);
 
@@ -342,4 +912,4 @@ TEST_F(MemoryTests, MemoryPrintMap) {
 	mem.mapRAM(0xf0, 0x100);
 
 	mem.printMap();
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+//
+// Tests for the Bus and the lines devices assert on it
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#if !defined(testClass)
+# error "Macro 'testClass' not defined"
+#endif
+
+std::vector<Byte> busTestProgram = {
+	0xe8,					// 1000: inx
+	0x4c, 0x00, 0x10		// 1001: jmp #$1000
+};
+
+// A device that asserts lines at given cycles, and latches what's written to it
+class lineDevice : public MemMappedDevice<Word, Byte> {
+public:
+	std::vector<std::pair<uint64_t, Lines>> lines;
+	Byte latch = 0;
+	int setups = 0;
+	int teardowns = 0;
+
+	lineDevice() {
+		_ioPorts = { 0 };
+	}
+
+	Byte Read([[maybe_unused]] const Word address) override {
+		return latch;
+	}
+
+	void Write([[maybe_unused]] const Word address, const Byte b) override {
+		latch = b;
+	}
+
+	void setup() override		{ setups++; }
+	void teardown() override	{ teardowns++; }
+
+	void startEvents(EventScheduler& scheduler) override {
+		for (size_t i = 0; i < lines.size(); i++)
+			scheduler.schedule(*this, lines[i].first, static_cast<int>(i));
+	}
+
+	Lines event([[maybe_unused]] EventScheduler& scheduler, [[maybe_unused]] const uint64_t cycle, const int id) override {
+		return lines[id].second;
+	}
+};
+
+TEST_F(testClass, BusMapsDevicesAndSetsThemUp) {
+	//Given:
+	Bus<decltype(cpu), Word, Byte> bus(cpu, mem, 1000);
+	auto device = std::make_shared<lineDevice>();
+
+	// When
+	bus.addDevice(device, 0xd010);
+	bus.setup();
+	mem[0xd010] = 0x42;
+	bus.teardown();
+
+	// Expect
+	EXPECT_EQ(device->latch, 0x42);
+	EXPECT_EQ(mem[0xd010], 0x42);
+	EXPECT_EQ(device->setups, 1);
+	EXPECT_EQ(device->teardowns, 1);
+}
+
+TEST_F(testClass, BusStopsTheCPUForDeviceEvents) {
+	//Given:
+	Bus<decltype(cpu), Word, Byte> bus(cpu, mem, 1000);
+	auto device = std::make_shared<lineDevice>();
+	device->lines = { { 100, Device::None } };
+	mem.loadData(busTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	bus.addDevice(device, 0xd010);
+
+	// When
+	auto cycles = bus.step();
+
+	// Expect; the last instruction may run past the event
+	EXPECT_GE(cycles, 100u);
+	EXPECT_LT(cycles, 100u + 7);
+	EXPECT_EQ(bus.scheduler().pendingEvents(), 0u);
+	EXPECT_GE(bus.step(), 1000u);
+}
+
+TEST_F(testClass, BusActsOnEveryLineAsserted) {
+	//Given:
+	Bus<decltype(cpu), Word, Byte> bus(cpu, mem, 1000);
+	auto device = std::make_shared<lineDevice>();
+	device->lines = { { 100, Device::IRQ }, { 200, Device::Reset }, { 200, Device::Exit } };
+	mem.loadData(busTestProgram, 0x1000);
+	mem.loadData(busTestProgram, 0x2000);
+	cpu.setResetVector(0x2000);
+	cpu.setInterruptVector(0x1000);
+	cpu.TestReset(0x1000);
+	bus.addDevice(device, 0xd010);
+
+	// When
+	bus.step();
+	EXPECT_TRUE(cpu.pendingIRQ());
+	EXPECT_FALSE(bus.exiting());
+	bus.step();
+
+	// Expect
+	EXPECT_FALSE(cpu.pendingIRQ());
+	EXPECT_EQ(cpu.getPC(), 0x2000);
+	EXPECT_TRUE(bus.exiting());
+}
@@ -324,4 +324,53 @@ TEST_F(testClass, SimultaneousNMIandIRQRunsNMIFirstAndThenRunsIRQAfterNMIComplet
 	EXPECT_FALSE(cpu.pendingNMI());
 	EXPECT_FALSE(cpu.getFlagI());
 
-}
\ No newline at end of file
+}
+
+// A timer that raises an IRQ every period cycles
+class timerDevice : public Device {
+public:
+	uint64_t period;
+	uint64_t lateness = 0;		// Most cycles an expiry was seen after it was due
+
+	timerDevice(const uint64_t p) : period(p) { }
+
+	void startEvents(EventScheduler& scheduler) override {
+		scheduler.schedule(*this, period, 0);
+	}
+
+	Lines event(EventScheduler& scheduler, const uint64_t cycle, [[maybe_unused]] const int id) override {
+		lateness = std::max(lateness, scheduler.now() - cycle);
+		scheduler.schedule(*this, cycle + period, 0);
+		return IRQ;
+	}
+};
+
+TEST_F(testClass, ScheduledIRQsArriveOnTime) {
+	std::vector<Byte> irqProgram = {
+		0xe6, 0x20,				// 3000: inc $20
+		0x40					//       rti
+	};
+
+	//Given:
+	EventScheduler scheduler(10000);
+	auto timer = std::make_shared<timerDevice>(1000);
+	mem.loadData(interruptTestProgram, 0x1000);
+	mem.loadData(irqProgram, 0x3000);
+	cpu.TestReset(0x1000);
+	cpu.setInterruptVector(0x3000);
+	scheduler.addDevice(timer);
+
+	// When
+	while (scheduler.now() < 20000) {
+		scheduler.advance(cpu.run(scheduler.nextSlice()));
+		scheduler.dispatch([&](const Device::Lines line) {
+			if (line == Device::IRQ)
+				cpu.raiseIRQ();
+		});
+	}
+
+	// Expect; the last IRQ is raised but not yet taken
+	EXPECT_EQ(mem[0x20], 19);
+	EXPECT_TRUE(cpu.pendingIRQ());
+	EXPECT_LT(timer->lateness, 7u);
+}
@@ -0,0 +1,298 @@
+//
+// Tests for batched execution via run() and runInstructions()
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#if !defined(testClass) 
+# error "Macro 'testClass' not defined"
+#endif
+
+std::vector<Byte> runTestProgram = {
+	0xca,					// 1000: dex
+	0xc8, 					// 1001: iny
+	0xca, 					// 1002: dex
+	0xc8, 					// 1003: iny
+	0x4c, 0x00, 0x10		// 1004: jmp #$1000
+};
+
+TEST_F(testClass, RunStopsAtHaltAddress) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.setHaltAddress(0x1004);
+
+	// When
+	auto cycles = cpu.run(1000);
+
+	// Expect
+	EXPECT_EQ(cpu.getPC(), 0x1004);
+	EXPECT_EQ(cycles, 8);
+	EXPECT_EQ(cpu.run(1000), 0);
+}
+
+TEST_F(testClass, RunStopsWhenCycleBudgetIsUsed) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+
+	// When
+	auto cycles = cpu.run(1000);
+
+	// Expect; the last instruction may run past the budget
+	EXPECT_GE(cycles, 1000);
+	EXPECT_LT(cycles, 1000 + 7);
+}
+
+TEST_F(testClass, RunInstructionsExecutesRequestedCount) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.setX(0x10);
+	cpu.setY(0x10);
+
+	// When
+	auto cycles = cpu.runInstructions(3);
+
+	// Expect
+	EXPECT_EQ(cpu.getPC(), 0x1003);
+	EXPECT_EQ(cpu.getX(), 0x0e);
+	EXPECT_EQ(cpu.getY(), 0x11);
+	EXPECT_EQ(cycles, 6);
+}
+
+TEST_F(testClass, RunTakesPendingInterrupt) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	Word initialSP = cpu.getSP();
+	cpu.setHaltAddress(0x4000);
+	cpu.setInterruptVector(0x4000);
+	cpu.raiseIRQ();
+
+	// When
+	cpu.run(1000);
+
+	// Expect
+	EXPECT_EQ(cpu.getPC(), 0x4000);
+	EXPECT_EQ(cpu.getSP(), initialSP - 3);
+	EXPECT_FALSE(cpu.pendingIRQ());
+}
+
+TEST_F(testClass, RunHoldsBlockedInterruptPending) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.setFlagI(true);
+	cpu.setInterruptVector(0x4000);
+	cpu.raiseIRQ();
+
+	// When
+	cpu.runInstructions(4);
+
+	// Expect
+	EXPECT_EQ(cpu.getPC(), 0x1004);
+	EXPECT_TRUE(cpu.pendingIRQ());
+}
+
+TEST_F(testClass, RunTakesBlockedInterruptOnceEnabled) {
+	//Given:
+	std::vector<Byte> program = {
+		0xe8,					// 1000: inx
+		0x58,					// 1001: cli
+		0xe8,					// 1002: inx
+		0xe8,					// 1003: inx
+	};
+	mem.loadData(program, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.setX(0);
+	cpu.setFlagI(true);
+	cpu.setHaltAddress(0x4000);
+	cpu.setInterruptVector(0x4000);
+	cpu.raiseIRQ();
+	Word initialSP = cpu.getSP();
+
+	// When
+	cpu.run(1000);
+
+	// Expect; the interrupt is taken straight after cli, returning to 0x1002
+	EXPECT_EQ(cpu.getPC(), 0x4000);
+	EXPECT_EQ(cpu.getX(), 1);
+	EXPECT_EQ(cpu.getSP(), initialSP - 3);
+	EXPECT_EQ(mem[0x0100 + initialSP - 1], 0x02);
+	EXPECT_EQ(mem[0x0100 + initialSP], 0x10);
+	EXPECT_FALSE(cpu.pendingIRQ());
+}
+
+TEST_F(testClass, RunDoesNothingInReset) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.setResetVector(0x1000);
+
+	// When
+	auto cycles = cpu.run(1000);
+
+	// Expect
+	EXPECT_TRUE(cpu.inReset());
+	EXPECT_EQ(cycles, 0);
+}
+
+TEST_F(testClass, StopEndsRun) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+
+	// When
+	cpu.stop();
+
+	// Expect; stop() only applies to the next run
+	EXPECT_EQ(cpu.run(1000), 0);
+	EXPECT_EQ(cpu.getPC(), 0x1000);
+	EXPECT_GE(cpu.run(1000), 1000);
+}
+
+TEST_F(testClass, RunThrowsOnInvalidOpcode) {
+	//Given:
+	cpu.TestReset(0x1000);
+	mem[0x1000] = 0x33;
+
+	// When/Expect
+	EXPECT_THROW(cpu.run(1000), std::runtime_error);
+	EXPECT_TRUE(cpu.hitException());
+	EXPECT_EQ(cpu.run(1000), 0);
+}
+
+TEST_F(testClass, RunSeesCodeModifiedByTheBlockItsRunning) {
+	//Given:
+	std::vector<Byte> program = {
+		0xa9, 0x42,				// 1000: lda #$42
+		0x8d, 0x06, 0x10,		// 1002: sta $1006
+		0xa2, 0x00,				// 1005: ldx #$00
+	};
+	mem.loadData(program, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.setHaltAddress(0x1007);
+
+	// When
+	cpu.run(1000);
+
+	// Expect
+	EXPECT_EQ(cpu.getPC(), 0x1007);
+	EXPECT_EQ(cpu.getX(), 0x42);
+}
+
+TEST_F(testClass, RunSeesCodeModifiedBetweenRuns) {
+	//Given:
+	std::vector<Byte> program = {
+		0xa2, 0x01,				// 1000: ldx #$01
+		0xa0, 0x02,				// 1002: ldy #$02
+	};
+	mem.loadData(program, 0x1000);
+	cpu.setHaltAddress(0x1004);
+	cpu.TestReset(0x1000);
+	cpu.run(1000);
+
+	// When
+	mem[0x1003] = 0x03;
+	cpu.TestReset(0x1000);
+	cpu.run(1000);
+
+	// Expect
+	EXPECT_EQ(cpu.getX(), 0x01);
+	EXPECT_EQ(cpu.getY(), 0x03);
+}
+
+TEST_F(testClass, RunWithoutBlockCacheUsesSameCycles) {
+	//Given:
+	mem.loadData(runTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	auto cachedCycles = cpu.runInstructions(100);
+	auto cachedPC = cpu.getPC();
+
+	// When
+	cpu.enableBlockCache(false);
+	cpu.TestReset(0x1000);
+	auto cycles = cpu.runInstructions(100);
+
+	// Expect
+	EXPECT_FALSE(cpu.isBlockCacheEnabled());
+	EXPECT_EQ(cycles, cachedCycles);
+	EXPECT_EQ(cpu.getPC(), cachedPC);
+}
+
+// Keeps every event it's given
+class recordingObserver : public Memory<Word, Byte>::Observer {
+public:
+	std::vector<event> events;
+
+	void observe(const std::span<const event> batch) override {
+		events.insert(events.end(), batch.begin(), batch.end());
+	}
+};
+
+TEST_F(testClass, RunReportsInstructionFetchesToObservers) {
+	//Given:
+	auto observer = std::make_shared<recordingObserver>();
+	mem.loadData(runTestProgram, 0x1000);
+	mem.attachObserver(observer, 0x1000, 0x1006, recordingObserver::Fetch);
+	cpu.TestReset(0x1000);
+
+	// When
+	cpu.runInstructions(10);
+
+	// Expect; two passes through the loop, seven bytes each
+	ASSERT_EQ(observer->events.size(), 14u);
+	EXPECT_EQ(observer->events.front().address, 0x1000);
+	EXPECT_EQ(observer->events.front().value, 0xca);
+	EXPECT_EQ(observer->events.back().address, 0x1006);
+	EXPECT_EQ(observer->events.back().access, recordingObserver::Fetch);
+}
+
+TEST_F(testClass, RunDoesntReportCodeAsReadsToObservers) {
+	//Given:
+	auto observer = std::make_shared<recordingObserver>();
+	mem.loadData(runTestProgram, 0x1000);
+	mem.attachObserver(observer, 0x1000, 0x1006, recordingObserver::Read);
+	cpu.TestReset(0x1000);
+
+	// When; the loop loads no data
+	cpu.run(1000);
+
+	// Expect
+	EXPECT_EQ(observer->events.size(), 0u);
+}
+
+TEST_F(testClass, RunSeesCodeInTheSelectedBank) {
+	//Given:
+	auto banks = std::make_shared<BankedMemory<Word, Byte>>(0x1000, 2);
+	mem.mapBanks(banks, 0x1000);
+	mem.loadData(runTestProgram, 0x1000);
+	banks->select(1);
+	mem.loadData({ 0xe8, 0xe8, 0x4c, 0x00, 0x10 }, 0x1000);	// inx; inx; jmp $1000
+
+	// When
+	cpu.TestReset(0x1000);
+	cpu.setX(0);
+	cpu.runInstructions(300);
+	banks->select(0);
+	cpu.TestReset(0x1000);
+	cpu.setX(0);
+	cpu.setY(0);
+	cpu.runInstructions(300);
+
+	// Expect; 60 passes through runTestProgram
+	EXPECT_EQ(cpu.getX(), 0x100 - 120);
+	EXPECT_EQ(cpu.getY(), 120);
+}
@@ -0,0 +1,141 @@
+//
+// Tests for machine snapshots
+//
+// Copyright (C) 2023 Walt Drummond
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#if !defined(testClass)
+# error "Macro 'testClass' not defined"
+#endif
+
+std::vector<Byte> snapshotTestProgram = {
+	0xe8,					// 1000: inx
+	0xc8, 					// 1001: iny
+	0x8a,					// 1002: txa
+	0x8d, 0x00, 0x20,		// 1003: sta $2000
+	0x8d, 0x10, 0xd0,		// 1006: sta $d010
+	0x4c, 0x00, 0x10		// 1009: jmp #$1000
+};
+
+// A device that remembers the last value written to it
+class snapshotTestDevice : public MemMappedDevice<Word, Byte> {
+public:
+	Byte latch = 0;
+
+	snapshotTestDevice() {
+		_ioPorts = { 0 };
+	}
+
+	Byte Read([[maybe_unused]] const Word address) override {
+		return latch;
+	}
+
+	void Write([[maybe_unused]] const Word address, const Byte b) override {
+		latch = b;
+	}
+
+	void saveState(SnapshotWriter& snapshot) override {
+		snapshot.putTag("TDEV");
+		snapshot.put<Byte>(latch);
+	}
+
+	SnapshotRestore readState(SnapshotReader& snapshot) override {
+		snapshot.expectTag("TDEV");
+		const auto value = snapshot.get<Byte>();
+		return [this, value] { latch = value; };
+	}
+};
+
+TEST_F(testClass, SnapshotRestoresCPUMemoryAndDevices) {
+	// Given:
+	auto device = std::make_shared<snapshotTestDevice>();
+	mem.mapDevice(device, 0xd010);
+	mem.loadData(snapshotTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	cpu.runInstructions(12);
+	auto snapshot = cpu.saveSnapshot();
+	auto pc = cpu.getPC();
+	auto x = cpu.getX();
+
+	// When:
+	cpu.runInstructions(25);
+	mem[0x3000] = 0x42;
+	cpu.restoreSnapshot(snapshot);
+
+	// Expect:
+	EXPECT_EQ(cpu.getPC(), pc);
+	EXPECT_EQ(cpu.getX(), x);
+	EXPECT_EQ(cpu.getA(), x);
+	EXPECT_EQ(mem[0x2000], x);
+	EXPECT_EQ(mem[0x3000], 0);
+	EXPECT_EQ(device->latch, x);
+	EXPECT_EQ(cpu.saveSnapshot(), snapshot);
+}
+
+TEST_F(testClass, RestoredMachineRunsLikeTheOriginal) {
+	// Given:
+	mem.loadData(snapshotTestProgram, 0x1000);
+	mem.mapDevice(std::make_shared<snapshotTestDevice>(), 0xd010);
+	cpu.TestReset(0x1000);
+	cpu.runInstructions(7);
+	auto snapshot = cpu.saveSnapshot();
+	cpu.run(500);
+	auto expected = cpu.saveSnapshot();
+
+	// When:
+	cpu.restoreSnapshot(snapshot);
+	cpu.run(500);
+
+	// Expect:
+	EXPECT_EQ(cpu.saveSnapshot(), expected);
+}
+
+TEST_F(testClass, RestoringABadSnapshotLeavesTheMachineAlone) {
+	// Given:
+	auto device = std::make_shared<snapshotTestDevice>();
+	mem.mapDevice(device, 0xd010);
+	mem.loadData(snapshotTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	auto snapshot = cpu.saveSnapshot();
+	mem[0x2000] = 0x42;
+	device->latch = 0x42;
+	cpu.setX(0x42);
+	auto before = cpu.saveSnapshot();
+
+	// When; the snapshot ends inside the device's section
+	snapshot.resize(snapshot.size() - 1);
+
+	// Expect:
+	EXPECT_ANY_THROW(cpu.restoreSnapshot(snapshot));
+	EXPECT_EQ(cpu.saveSnapshot(), before);
+	EXPECT_EQ(mem[0x2000], 0x42);
+	EXPECT_EQ(device->latch, 0x42);
+}
+
+TEST_F(testClass, RestoringASnapshotWithTrailingDataLeavesTheMachineAlone) {
+	// Given:
+	mem.loadData(snapshotTestProgram, 0x1000);
+	cpu.TestReset(0x1000);
+	auto snapshot = cpu.saveSnapshot();
+	mem[0x2000] = 0x42;
+	auto before = cpu.saveSnapshot();
+
+	// When:
+	snapshot.push_back(0);
+
+	// Expect:
+	EXPECT_ANY_THROW(cpu.restoreSnapshot(snapshot));
+	EXPECT_EQ(cpu.saveSnapshot(), before);
+}
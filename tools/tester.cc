@@ -25,6 +25,7 @@
 #include <memory.h>
 
 #include "mos6820.h"
+#include "bus.h"
 
 using Address = uint16_t;
 using Byte    = uint8_t;
@@ -103,10 +104,11 @@ int main(int argc, char* argv[]) {
 
 	constexpr Address PIA_BASE_ADDRESS = 0xd010;
 
-	// Create the memory, CPU, PIA and bus clock
+	// Create the memory, CPU, PIA and bus, which runs at most 10000 cycles between device events
 	Memory<Address, Byte> mem(MOS65C02::LAST_ADDRESS);
-	MOS65C02 cpu(mem);
+	R65C02 cpu(mem);
 	auto pia = std::make_shared<MOS6820<Address, Byte>>();
+	Bus<R65C02, Address, Byte> bus(cpu, mem, 10000);
 
 	fmt::print("  Reset        = Control-\\\n");
 	fmt::print("  Clear screen = Control-[\n");
@@ -115,8 +117,8 @@ int main(int argc, char* argv[]) {
 
 	mem.Reset();
 	mem.mapRAM(0x0000, 0xffff);
-    mem.mapDevice(pia, PIA_BASE_ADDRESS);
-	pia->setTermNonblocking();	
+	bus.addDevice(pia, PIA_BASE_ADDRESS);
+	bus.setup();
 
 	fmt::print("Loading {} at {:04x}, start address {:04x}", testFile, loadAddress, startAddress);
 	if (haveHaltAddress) {
@@ -134,41 +136,15 @@ int main(int argc, char* argv[]) {
 
 	cpu.setDebugMode(startInDebugger);
 
-	 while (!cpu.isPCAtHaltAddress()) {
-		// If we're in debug mode we have to toggle the terminal out of and in to non-blocking mode
-		// so the CPU debugger (implemented in the CPU class) can access the terminal in non-blocking 
-		// mode.
-		auto debug = cpu.isInDebugMode();
-		if (debug) 
-				pia->setTermBlocking();
-		
-		cpu.execute();
-		
-		if (debug) 
-				pia->setTermNonblocking();
-
-		auto signals = pia->housekeeping();
-
-		for (const auto& signal : signals) {
-				switch(signal) {
-				case Device::None:
-						break;
-				case Device::Reset:
-						cpu.Reset();
-						if (cpu.inReset()) 
-								cpu.Reset();
-						break;
-				case Device::Debug:
-						cpu.setDebugMode(true);
-						break;
-				case Device::Exit:
-						fmt::print("\nExiting emulator\n");
-						std::exit(0);
-				}
-		}
+	while (!cpu.isPCAtHaltAddress() && !bus.exiting())
+		bus.step();
+
+	bus.teardown();
+	if (bus.exiting()) {
+		fmt::print("\nExiting emulator\n");
+		return 0;
 	}
 
-	pia->setTermNonblocking();	
 	fmt::print("Test passed\n");
 
 	return 0;